@@ -36,7 +36,7 @@ class App
 
  private:
   std::unique_ptr<ICalculatorModel> m_model{};
-  std::unique_ptr<IController> m_controller{};
+  std::unique_ptr<CliController> m_controller{};
   CliView m_view;
 
 }; // class App
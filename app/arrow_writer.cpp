@@ -0,0 +1,339 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "arrow_writer.h"
+
+#include <array>
+#include <bit>
+#include <initializer_list>
+#include <type_traits>
+
+namespace
+{
+using namespace pascha;
+
+// Builds Flatbuffers front to back. Every object is written after the offset
+// that refers to it, so offsets are always forward, as Flatbuffers requires.
+// Each object is given the position of the offset to point at it, which is
+// set once the object has been aligned. The root offset is at position 0.
+class FlatBufferBuilder
+{
+ public:
+  FlatBufferBuilder() { put<std::uint32_t>(0); }
+
+  const std::vector<std::uint8_t>& bytes() const { return m_bytes; }
+  std::size_t size() const { return m_bytes.size(); }
+
+  // Set a little-endian scalar at the given position.
+  template <typename T>
+  void set(std::size_t at, T value)
+  {
+    auto bits{static_cast<std::make_unsigned_t<T>>(value)};
+    for (std::size_t i{0}; i < sizeof(T); ++i) {
+      m_bytes[at + i] = static_cast<std::uint8_t>(bits >> (8 * i));
+    }
+  } // set
+
+  template <typename T>
+  void put(T value)
+  {
+    m_bytes.resize(size() + sizeof(T));
+    set(size() - sizeof(T), value);
+  } // put
+
+  // Pad with zeros until the size is remainder modulo alignment.
+  void pad(std::size_t alignment, std::size_t remainder = 0)
+  {
+    while (size() % alignment != remainder) { m_bytes.push_back(0); }
+  } // pad
+
+  // Write a table whose fields, by id, are the given number of bytes, or 0 for
+  // a field that is left out. Returns the position of each field to be set.
+  std::vector<std::size_t> table(std::size_t slot,
+                                 std::initializer_list<std::size_t> sizes)
+  {
+    // The fields follow the offset to the vtable, largest first so that each
+    // is aligned to its size.
+    std::vector<std::size_t> offsets(sizes.size(), 0);
+    std::size_t table_size{4};
+    for (std::size_t field_size : {8, 4, 2, 1}) {
+      std::size_t id{0};
+      for (std::size_t size : sizes) {
+        if (size == field_size) {
+          offsets[id] = (table_size + size - 1) / size * size;
+          table_size = offsets[id] + size;
+        }
+        ++id;
+      }
+    }
+
+    pad(2);
+    std::size_t vtable{size()};
+    put(static_cast<std::uint16_t>(4 + 2 * sizes.size()));
+    put(static_cast<std::uint16_t>(table_size));
+    for (std::size_t offset : offsets) {
+      put(static_cast<std::uint16_t>(offset));
+    }
+
+    pad(8);
+    point(slot);
+    std::size_t table{size()};
+    put(static_cast<std::int32_t>(table - vtable));
+    m_bytes.resize(table + table_size);
+
+    std::vector<std::size_t> fields(sizes.size(), 0);
+    for (std::size_t id{0}; id < fields.size(); ++id) {
+      fields[id] = table + offsets[id];
+    }
+    return fields;
+  } // table
+
+  // Write a vector of count elements of the given size and alignment, returning
+  // the position of the first element.
+  std::size_t vector(std::size_t slot, std::size_t count,
+                     std::size_t element_size, std::size_t alignment)
+  {
+    pad(alignment, alignment - 4);
+    point(slot);
+    put(static_cast<std::uint32_t>(count));
+    std::size_t first{size()};
+    m_bytes.resize(first + count * element_size);
+    return first;
+  } // vector
+
+  void string(std::size_t slot, std::string_view text)
+  {
+    pad(4);
+    point(slot);
+    put(static_cast<std::uint32_t>(text.size()));
+    m_bytes.insert(m_bytes.end(), text.begin(), text.end());
+    m_bytes.push_back(0);
+  } // string
+
+ private:
+  std::vector<std::uint8_t> m_bytes{};
+
+  void point(std::size_t slot)
+  {
+    set(slot, static_cast<std::uint32_t>(size() - slot));
+  } // point
+}; // class FlatBufferBuilder
+
+// Values from the Arrow format's Schema.fbs and Message.fbs.
+constexpr std::int16_t kMetadataVersionV5{4};
+constexpr std::uint8_t kHeaderSchema{1};
+constexpr std::uint8_t kHeaderRecordBatch{3};
+constexpr std::uint8_t kTypeInt{2};
+constexpr std::uint8_t kTypeUtf8{5};
+constexpr std::int16_t kEndianness{std::endian::native == std::endian::big};
+constexpr std::uint32_t kContinuation{0xFFFFFFFF};
+
+struct Column
+{
+  std::string_view name;
+  std::uint8_t type;
+  std::int32_t bit_width; // for integers only
+}; // struct Column
+
+constexpr std::array<Column, 6> kColumns{{
+    {"year", kTypeInt, 64},
+    {"target", kTypeUtf8, 0},
+    {"calendar", kTypeUtf8, 0},
+    {"month", kTypeInt, 8},
+    {"day", kTypeInt, 8},
+    {"jdn", kTypeInt, 64},
+}};
+
+constexpr std::size_t kBufferCount{14}; // validity and data, plus offsets
+
+std::size_t padded(std::size_t size) { return (size + 7) / 8 * 8; }
+
+void writeUint32(std::ostream& stream, std::uint32_t value)
+{
+  std::array<char, 4> bytes{};
+  for (std::size_t i{0}; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<char>(value >> (8 * i));
+  }
+  stream.write(bytes.data(), bytes.size());
+} // writeUint32
+
+} // anonymous namespace
+
+namespace pascha
+{
+ArrowWriter::ArrowWriter(std::ostream& stream) : m_stream{stream}
+{
+  writeSchema();
+} // ArrowWriter::ArrowWriter(std::ostream&)
+
+ArrowWriter::~ArrowWriter() { finish(); }
+
+void ArrowWriter::append(const Date& date, std::string_view target,
+                         std::string_view calendar, CalcInt jdn)
+{
+  m_years.push_back(date.year);
+  m_targets.append(target);
+  m_calendars.append(calendar);
+  m_months.push_back(static_cast<std::int8_t>(date.month));
+  m_days.push_back(static_cast<std::int8_t>(date.day));
+  m_jdns.push_back(jdn);
+} // ArrowWriter::append(const Date&, std::string_view, ...)
+
+void ArrowWriter::writeBatch()
+{
+  if (m_years.empty()) { return; }
+  auto rows{static_cast<std::int64_t>(m_years.size())};
+
+  // Every column has an empty validity buffer, as nothing is null, followed by
+  // its offsets for strings and then its values.
+  struct Buffer
+  {
+    const void* data;
+    std::size_t size;
+  }; // struct Buffer
+
+  auto bytes{[](const auto& values) {
+    return Buffer{values.data(), values.size() * sizeof(values[0])};
+  }};
+  std::array<Buffer, kBufferCount> buffers{{
+      {nullptr, 0},
+      bytes(m_years),
+      {nullptr, 0},
+      bytes(m_targets.offsets),
+      bytes(m_targets.data),
+      {nullptr, 0},
+      bytes(m_calendars.offsets),
+      bytes(m_calendars.data),
+      {nullptr, 0},
+      bytes(m_months),
+      {nullptr, 0},
+      bytes(m_days),
+      {nullptr, 0},
+      bytes(m_jdns),
+  }};
+
+  FlatBufferBuilder builder{};
+  auto message{builder.table(0, {2, 1, 4, 8})};
+  builder.set(message[0], kMetadataVersionV5);
+  builder.set(message[1], kHeaderRecordBatch);
+
+  auto batch{builder.table(message[2], {8, 4, 4})};
+  builder.set(batch[0], rows);
+
+  std::size_t node{builder.vector(batch[1], kColumns.size(), 16, 8)};
+  for (std::size_t i{0}; i < kColumns.size(); ++i, node += 16) {
+    builder.set(node, rows);
+    builder.set(node + 8, std::int64_t{0}); // null count
+  }
+
+  std::size_t buffer{builder.vector(batch[2], buffers.size(), 16, 8)};
+  std::int64_t body_length{0};
+  for (const Buffer& b : buffers) {
+    builder.set(buffer, body_length);
+    builder.set(buffer + 8, static_cast<std::int64_t>(b.size));
+    body_length += static_cast<std::int64_t>(padded(b.size));
+    buffer += 16;
+  }
+  builder.set(message[3], body_length);
+
+  writeMessage(builder.bytes());
+  for (const Buffer& b : buffers) { writeBody(b.data, b.size); }
+
+  m_years.clear();
+  m_targets.clear();
+  m_calendars.clear();
+  m_months.clear();
+  m_days.clear();
+  m_jdns.clear();
+} // ArrowWriter::writeBatch()
+
+void ArrowWriter::finish()
+{
+  if (m_finished) { return; }
+  writeBatch();
+  writeUint32(m_stream, kContinuation);
+  writeUint32(m_stream, 0);
+  m_stream.flush();
+  m_finished = true;
+} // ArrowWriter::finish()
+
+void ArrowWriter::writeSchema()
+{
+  FlatBufferBuilder builder{};
+  auto message{builder.table(0, {2, 1, 4})};
+  builder.set(message[0], kMetadataVersionV5);
+  builder.set(message[1], kHeaderSchema);
+
+  auto schema{builder.table(message[2], {2, 4})};
+  builder.set(schema[0], kEndianness);
+
+  std::size_t slot{builder.vector(schema[1], kColumns.size(), 4, 4)};
+  for (const Column& column : kColumns) {
+    // name, nullable, type_type, type, dictionary (left out), children
+    auto field{builder.table(slot, {4, 1, 1, 4, 0, 4})};
+    builder.set(field[2], column.type);
+    builder.string(field[0], column.name);
+    if (column.type == kTypeInt) {
+      auto type{builder.table(field[3], {4, 1})};
+      builder.set(type[0], column.bit_width);
+      builder.set(type[1], std::uint8_t{1}); // is_signed
+    } else {
+      builder.table(field[3], {});
+    }
+    builder.vector(field[5], 0, 4, 4);
+    slot += 4;
+  }
+
+  writeMessage(builder.bytes());
+} // ArrowWriter::writeSchema()
+
+void ArrowWriter::writeMessage(const std::vector<std::uint8_t>& metadata)
+{
+  // The continuation marker and length, then the metadata padded so that the
+  // body, written separately, starts on a multiple of 8 bytes.
+  writeUint32(m_stream, kContinuation);
+  writeUint32(m_stream, static_cast<std::uint32_t>(padded(metadata.size())));
+  writeBody(metadata.data(), metadata.size());
+} // ArrowWriter::writeMessage(const std::vector<std::uint8_t>&)
+
+void ArrowWriter::writeBody(const void* data, std::size_t size)
+{
+  static constexpr std::array<char, 8> kPadding{};
+  if (size > 0) {
+    m_stream.write(static_cast<const char*>(data),
+                   static_cast<std::streamsize>(size));
+  }
+  m_stream.write(kPadding.data(),
+                 static_cast<std::streamsize>(padded(size) - size));
+} // ArrowWriter::writeBody(const void*, std::size_t)
+
+void ArrowWriter::Strings::append(std::string_view value)
+{
+  data.insert(data.end(), value.begin(), value.end());
+  offsets.push_back(static_cast<std::int32_t>(data.size()));
+} // ArrowWriter::Strings::append(std::string_view)
+
+void ArrowWriter::Strings::clear()
+{
+  offsets.resize(1);
+  data.clear();
+} // ArrowWriter::Strings::clear()
+
+} // namespace pascha
@@ -0,0 +1,84 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_ARROW_WRITER_H
+#define PASCHA_ARROW_WRITER_H
+
+#include "pascha/date.h"
+#include "pascha/typedefs.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace pascha
+{
+
+// Writes dates as an Apache Arrow IPC stream: a schema, then a record batch
+// each time writeBatch is called, then the end of stream marker from finish.
+// The columns are year (int64), target (utf8), calendar (utf8), month (int8),
+// day (int8) and jdn (int64), none of which are nullable. The Flatbuffers
+// metadata is encoded by hand, so there is no dependency on Arrow itself.
+class ArrowWriter
+{
+ public:
+  explicit ArrowWriter(std::ostream& stream);
+  ArrowWriter(const ArrowWriter&) = delete;
+  ArrowWriter(ArrowWriter&&) = delete;
+  ArrowWriter& operator=(const ArrowWriter&) = delete;
+  ArrowWriter& operator=(ArrowWriter&&) = delete;
+  ~ArrowWriter();
+
+  // Add a row to the next record batch.
+  void append(const Date& date, std::string_view target,
+              std::string_view calendar, CalcInt jdn);
+  // Write the rows appended since the last batch, if there are any.
+  void writeBatch();
+  void finish();
+
+ private:
+  // A utf8 column, as its offsets and the characters of every value.
+  struct Strings
+  {
+    std::vector<std::int32_t> offsets{0};
+    std::vector<char> data{};
+
+    void append(std::string_view value);
+    void clear();
+  }; // struct Strings
+
+  std::ostream& m_stream;
+  std::vector<std::int64_t> m_years{};
+  Strings m_targets{};
+  Strings m_calendars{};
+  std::vector<std::int8_t> m_months{};
+  std::vector<std::int8_t> m_days{};
+  std::vector<std::int64_t> m_jdns{};
+  bool m_finished{false};
+
+  void writeSchema();
+  void writeMessage(const std::vector<std::uint8_t>& metadata);
+  void writeBody(const void* data, std::size_t size);
+}; // class ArrowWriter
+
+} // namespace pascha
+#endif // !PASCHA_ARROW_WRITER_H
@@ -19,16 +19,127 @@
 // reporting.
 
 #include "cli_controller.h"
+#include "arrow_writer.h"
 #include "cli_view.h"
 
 #include "pascha/calculation_methods.h"
-#include "pascha/output_calendars.h"
-#include "pascha/output_options.h"
-#include "pascha/target_dates.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/pascha_calculator_model.h"
+#include "pascha/pascha_index.h"
+#include "pascha/static_pipeline.h"
+#include "pascha/weeks_between.h"
+#include "work_stealing_pool.h"
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <ctime>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <string>
+#include <variant>
+
+namespace
+{
+using namespace pascha;
+
+// Call f for every year in the range, in order. The distance to the end of the
+// range is computed unsigned so that ranges reaching the limits of Year do not
+// overflow.
+template <typename F>
+void forEachYear(const YearRange& range, F f)
+{
+  Year year{range.from};
+  auto step{static_cast<std::uint64_t>(range.step)};
+  if (range.from <= range.to) {
+    while (true) {
+      f(year);
+      if (static_cast<std::uint64_t>(range.to) -
+              static_cast<std::uint64_t>(year) <
+          step) {
+        break;
+      }
+      year += range.step;
+    }
+  } else {
+    while (true) {
+      f(year);
+      if (static_cast<std::uint64_t>(year) -
+              static_cast<std::uint64_t>(range.to) <
+          step) {
+        break;
+      }
+      year -= range.step;
+    }
+  }
+} // forEachYear
+
+std::string_view targetName(ETargetOutput target)
+{
+  switch (target) {
+    case e_target_output::meatfare: return "meatfare";
+    case e_target_output::cheesefare: return "cheesefare";
+    case e_target_output::ashWednesday: return "ash_wednesday";
+    case e_target_output::midfeastPentecost: return "midfeast_of_pentecost";
+    case e_target_output::leavetakingPascha: return "leavetaking_of_pascha";
+    case e_target_output::ascension: return "ascension";
+    case e_target_output::pentecost: return "pentecost";
+    default: return "pascha";
+  }
+} // targetName
+
+std::string_view calendarName(EOutputCalendar calendar)
+{
+  switch (calendar) {
+    case e_output_calendar::gregorian: return "gregorian";
+    case e_output_calendar::rev_julian: return "revised_julian";
+    default: return "julian";
+  }
+} // calendarName
+
+// The Julian Day Number of a date as it is output in the given calendar,
+// undoing the Anno Mundi year of a Byzantine date.
+Checked<CalcInt> outputJdn(Date date, EOutputCalendar calendar,
+                           bool byzantine)
+{
+  if (byzantine) {
+    date.year -= 5508;
+    if (date.month > 8) { --date.year; }
+  }
+  switch (calendar) {
+    case e_output_calendar::gregorian: return tryGregorianToJdn(date);
+    case e_output_calendar::rev_julian: return tryRevJulianToJdn(date);
+    default: return tryJulianToJdn(date);
+  }
+} // outputJdn
+
+// Keeps the notifications from a model so that they can be passed on later,
+// in the same order, by another model.
+class RecordingObserver : public IObserver
+{
+ public:
+  using Record = std::variant<Date, Weeks, Days, std::string>;
+
+  void update(const Date& date) override { m_records.emplace_back(date); }
+  void update(Weeks weeks) override { m_records.emplace_back(weeks); }
+  void update(Days days) override { m_records.emplace_back(days); }
+  void update(std::string_view message) override
+  {
+    m_records.emplace_back(std::string{message});
+  }
+
+  const std::vector<Record>& records() const { return m_records; }
+
+ private:
+  std::vector<Record> m_records{};
+}; // class RecordingObserver
+
+} // anonymous namespace
 
 namespace pascha
 {
@@ -41,26 +152,19 @@ void CliController::calculate(const CalculationOptions& options) const
   Year year{};
   bool given_year{true};
 
-  // struct for redirecting std::cout to a buffer for daysUntil output.
-  struct cout_redirect
-  {
-    cout_redirect(std::streambuf* new_buffer) : old(std::cout.rdbuf(new_buffer))
-    {
-    }
-
-    ~cout_redirect() { std::cout.rdbuf(old); }
-
-   private:
-    std::streambuf* old;
-  };
-
-  // Ensure the year is valid before continuing.
+  // Ensure the years are valid before continuing.
   if (!validateYear(options.year)) {
     m_model->notify("Invalid year"sv);
     return;
   }
+  for (const YearRange& range : options.years) {
+    if (!validateYear(range.from) || !validateYear(range.to)) {
+      m_model->notify("Invalid year"sv);
+      return;
+    }
+  }
 
-  if (options.year == -9223372036854775807) {
+  if (options.year == -9223372036854775807 && options.years.empty()) {
     auto now{std::chrono::system_clock::now()};
     auto nowTime{std::chrono::system_clock::to_time_t(now)};
     auto currYear{std::localtime(&nowTime)->tm_year + 1900};
@@ -71,8 +175,10 @@ void CliController::calculate(const CalculationOptions& options) const
     given_year = true;
   }
 
-  // Check the options for verbose output and Pascha name.
+  // Check the options for verbose output, Pascha name and output format.
   bool verbose{false};
+  bool arrow{false};
+  bool byzantine{false};
   std::string_view pascha_name{"Pascha"sv};
 
   for (auto option : options.options) {
@@ -85,158 +191,577 @@ void CliController::calculate(const CalculationOptions& options) const
           break;
         }
       }
+      case (e_output_option::arrow): {
+        arrow = true;
+        break;
+      }
+      case (e_output_option::byzantine): {
+        byzantine = true;
+        break;
+      }
     }
   }
 
+  // Build the calculation method for each target output once, so that it can
+  // be reused for every year.
+  std::vector<Job> jobs{};
+
   for (auto target_output : options.target_outputs) {
 
     // Check if we are calculating weeks between two methods, before creating
-    // the method object. If so, perform the calculation and continue.
+    // the method object. If so, add the two methods to compare and continue.
     if (target_output == e_target_output::weeksBetween) {
-      std::unique_ptr<ICalculationMethod> julian_method{
-          new JulianCalculationMethod{}};
-      std::unique_ptr<ICalculationMethod> gregorian_method{
-          new GregorianCalculationMethod{}};
-      std::cout << "Weeks between calendars: ";
-      m_model->weeksBetween(year, std::move(julian_method),
-                            std::move(gregorian_method));
+      jobs.push_back(Job{target_output, "Weeks between calendars: ",
+                         std::make_shared<JulianCalculationMethod>(),
+                         std::make_shared<GregorianCalculationMethod>()});
       continue;
     }
 
-    std::unique_ptr<ICalculationMethod> method{nullptr};
+    std::string label{};
 
-    // 1. get the calculation method from the options.
-    // Default to Julian.
-    switch (options.calculation_method) {
-      case e_calculation_method::gregorian: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new GregorianCalculationMethod{}};
-        break;
-      }
-      default: {
-        method =
-            std::unique_ptr<ICalculationMethod>{new JulianCalculationMethod{}};
-        break;
-      }
-    }
-
-    // 2. Get the target date.
+    // 1. Get the label for the target date.
     // Default to Pascha.
     switch (target_output) {
       case e_target_output::daysUntil: {
-        m_model->setCalculationMethod(std::move(method));
-        if (verbose) std::cout << "Days until " << pascha_name << ": ";
-
-        if (!given_year) {
-          // Check if Pascha has already passed this year.
-          std::string text;
-          {
-            std::stringstream buffer;
-            cout_redirect redirect{buffer.rdbuf()};
-            m_model->daysUntil(year);
-            text = buffer.str();
-          }
-          long long int days_until_value{0};
-          try {
-            days_until_value = std::stoll(text);
-          } catch (const std::invalid_argument& e) {
-            std::cerr << "Invalid number: " << text;
-            continue;
-          }
-          if (days_until_value < 0) {
-            m_model->daysUntil(year + 1);
-            continue;
-          }
+        if (verbose) {
+          label = "Days until ";
+          label += pascha_name;
+          label += ": ";
         }
-
-        m_model->daysUntil(year);
-        continue;
+        break;
       }
       case e_target_output::meatfare: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new Meatfare{std::move(method)}};
-        if (verbose) std::cout << "Meatfare: ";
+        if (verbose) label = "Meatfare: ";
         break;
       }
       case e_target_output::cheesefare: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new Cheesefare{std::move(method)}};
-        if (verbose) std::cout << "Cheesefare: ";
+        if (verbose) label = "Cheesefare: ";
         break;
       }
       case e_target_output::ashWednesday: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new AshWednesday{std::move(method)}};
-        if (verbose) std::cout << "Ash Wednesday: ";
+        if (verbose) label = "Ash Wednesday: ";
         break;
       }
       case e_target_output::midfeastPentecost: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new MidfeastPentecost{std::move(method)}};
-        if (verbose) std::cout << "Midfeast of Pentecost: ";
+        if (verbose) label = "Midfeast of Pentecost: ";
         break;
       }
       case e_target_output::leavetakingPascha: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new LeavetakingPascha{std::move(method)}};
-        if (verbose) std::cout << "Leavetaking of Pascha: ";
+        if (verbose) label = "Leavetaking of Pascha: ";
         break;
       }
       case e_target_output::ascension: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new Ascension{std::move(method)}};
-        if (verbose) std::cout << "Ascension: ";
+        if (verbose) label = "Ascension: ";
         break;
       }
       case e_target_output::pentecost: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new Pentecost{std::move(method)}};
-        if (verbose) std::cout << "Pentecost: ";
+        if (verbose) label = "Pentecost: ";
         break;
       }
       default: {
         // Pascha is calculated by default already.
-        if (verbose) std::cout << pascha_name << ": ";
+        if (verbose) {
+          label = pascha_name;
+          label += ": ";
+        }
         break;
       }
     }
 
-    // 3. Set the output calendar.
-    // Default to Julian.
-    switch (options.output_calendar) {
-      case e_output_calendar::gregorian: {
-        // Gregorian is used by default for calculations.
-        break;
+    // 2. Select the pipeline for the calculation method, target date, output
+    // calendar and options. Days until counts to Pascha in the Gregorian
+    // calendar, as the calculation method gives it.
+    std::shared_ptr<ICalculationMethod> method{nullptr};
+    if (target_output == e_target_output::daysUntil) {
+      method = makeStaticPipeline(options.calculation_method,
+                                  e_target_output::pascha,
+                                  e_output_calendar::gregorian, false);
+    } else {
+      method = makeStaticPipeline(options.calculation_method, target_output,
+                                  options.output_calendar, byzantine);
+    }
+    if (!method) {
+      m_model->notify("Unknown target output"sv);
+      return;
+    }
+
+    jobs.push_back(Job{target_output, label, method, nullptr,
+                       staticPipelineFinish(target_output,
+                                            options.output_calendar,
+                                            byzantine)});
+  }
+  std::shared_ptr<ICalculationMethod> pascha{
+      makeStaticPipeline(options.calculation_method, e_target_output::pascha,
+                         e_output_calendar::gregorian, false)};
+
+  // 5. Calculate each year, either the single year or every year in the
+  // given ranges. A search or statistics without a year look through the next
+  // century.
+  if (options.statistics) {
+    if (arrow) {
+      m_model->notify("Statistics can not be written in the Arrow format"sv);
+      return;
+    }
+    calculateStatistics(options,
+                        options.years.empty()
+                            ? std::vector{YearRange{year, year + 99}}
+                            : options.years,
+                        byzantine);
+    return;
+  }
+  if (options.search_month != 0 || options.search_weeks) {
+    calculateSearch(jobs, *pascha, options,
+                    options.years.empty() ? std::vector{YearRange{year,
+                                                                  year + 99}}
+                                          : options.years,
+                    arrow, byzantine);
+    return;
+  }
+  if (arrow) {
+    calculateArrow(jobs,
+                   options.years.empty() ? std::vector{YearRange{year, year}}
+                                         : options.years,
+                   options.output_calendar, byzantine);
+    return;
+  }
+  if (options.years.empty()) {
+    calculateYear(jobs, year, given_year, *m_model, true);
+    return;
+  }
+
+  if (options.threads > 1) {
+    calculateParallel(jobs, *pascha, options.years, options.threads);
+    return;
+  }
+
+  constexpr std::size_t kBlockSize{4096};
+  std::vector<Year> block{};
+  block.reserve(kBlockSize);
+
+  for (const YearRange& range : options.years) {
+    forEachYear(range, [&](Year y) {
+      block.push_back(y);
+      if (block.size() == kBlockSize) {
+        calculateYears(jobs, *pascha, block, *m_model, true);
+        block.clear();
       }
-      case e_output_calendar::rev_julian: {
-        method = std::unique_ptr<ICalculationMethod>{
-            new RevisedJulianOutputCalendar{std::move(method)}};
-        break;
+    });
+  }
+  if (!block.empty()) { calculateYears(jobs, *pascha, block, *m_model, true); }
+
+} // CliController::calculate(const CalculationOptions&) const
+
+void CliController::calculateYears(const std::vector<Job>& jobs,
+                                   const ICalculationMethod& pascha,
+                                   std::span<const Year> years,
+                                   ICalculatorModel& model,
+                                   bool print_labels) const
+{
+  // With a single date output and no label to print before each date, the
+  // years are passed through the model at once. Otherwise each year is
+  // calculated in turn so that all of its outputs stay together.
+  bool batch{jobs.size() == 1 && jobs.front().label.empty() &&
+             jobs.front().target != e_target_output::daysUntil &&
+             jobs.front().target != e_target_output::weeksBetween};
+
+  if (batch) {
+    model.setCalculationMethod(jobs.front().method, jobs.front().target);
+    model.calculate(years);
+    return;
+  }
+
+  // Calculate Pascha for all of the years at once, with the error of each
+  // year that can not be calculated.
+  std::vector<Date> paschas(years.size());
+  std::vector<EConversionError> errors(years.size());
+  pascha.tryCalculate(years, paschas, errors);
+
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    for (const Job& job : jobs) {
+      if (print_labels) { *m_out << job.label; }
+      if (!job.finish) {
+        calculateJob(job, years[i], true, model);
+      } else if (errors[i] != e_conversion_error::none) {
+        model.notify(conversionErrorMessage(errors[i]));
+      } else if (Checked<Date> date{job.finish(paschas[i])}) {
+        model.notify(*date);
+      } else {
+        model.notify(conversionErrorMessage(date.error));
       }
-      default: { // Julian
-        method = std::unique_ptr<ICalculationMethod>{
-            new JulianOutputCalendar{std::move(method)}};
-        break;
+    }
+  }
+} // CliController::calculateYears(const std::vector<Job>&, ...) const
+
+void CliController::calculateParallel(const std::vector<Job>& jobs,
+                                      const ICalculationMethod& pascha,
+                                      const std::vector<YearRange>& ranges,
+                                      std::size_t threads) const
+{
+  // Each chunk is calculated through a model of its own, whose notifications
+  // are recorded. Every year notifies exactly one result per job, so the
+  // label for a record follows from its position.
+  struct Chunk
+  {
+    std::vector<Year> years{};
+    RecordingObserver recorder{};
+    bool done{};
+  }; // struct Chunk
+
+  constexpr std::size_t kChunkSize{16384};
+  // Only a few chunks per thread are held at once, so memory stays bounded
+  // however long the ranges are.
+  const std::size_t window{threads * 4};
+
+  std::mutex mutex{};
+  std::condition_variable finished{};
+  std::deque<std::unique_ptr<Chunk>> pending{};
+  WorkStealingPool pool{threads};
+
+  auto printFront{[&] {
+    Chunk& chunk{*pending.front()};
+    {
+      std::unique_lock lock{mutex};
+      finished.wait(lock, [&] { return chunk.done; });
+    }
+    const auto& records{chunk.recorder.records()};
+    if (jobs.size() == 1 && jobs.front().label.empty()) {
+      // Without labels between them, each run of dates is passed on as a
+      // block, for which the record of each year is at its position.
+      std::vector<Date> run{};
+      for (std::size_t i{0}; i < records.size(); ++i) {
+        if (const Date* date{std::get_if<Date>(&records[i])}) {
+          run.push_back(*date);
+          if (i + 1 < records.size() &&
+              std::holds_alternative<Date>(records[i + 1])) {
+            continue;
+          }
+          std::span<const Year> years{chunk.years};
+          m_model->notify(run, DatesMetadata{years.subspan(i + 1 - run.size(),
+                                                           run.size()),
+                                             jobs.front().target});
+          run.clear();
+        } else {
+          std::visit([this](const auto& record) { m_model->notify(record); },
+                     records[i]);
+        }
+      }
+    } else {
+      for (std::size_t i{0}; i < records.size(); ++i) {
+        *m_out << jobs[i % jobs.size()].label;
+        std::visit([this](const auto& record) { m_model->notify(record); },
+                   records[i]);
       }
     }
+    pending.pop_front();
+  }};
 
-    // 4. Apply the options.
-    for (auto option : options.options) {
-      switch (option) {
-        case (e_output_option::byzantine): {
-          method = std::unique_ptr<ICalculationMethod>{
-              new ByzantineDate{std::move(method)}};
-          break;
+  auto submit{[&](std::vector<Year>& years) {
+    if (pending.size() == window) { printFront(); }
+    pending.push_back(std::make_unique<Chunk>());
+    Chunk* chunk{pending.back().get()};
+    chunk->years.swap(years);
+    pool.submit([&, chunk] {
+      PaschaCalculatorModel model{};
+      model.addObserver(chunk->recorder);
+      calculateYears(jobs, pascha, chunk->years, model, false);
+      {
+        std::lock_guard lock{mutex};
+        chunk->done = true;
+      }
+      finished.notify_all();
+    });
+    years.clear();
+    years.reserve(kChunkSize);
+  }};
+
+  std::vector<Year> years{};
+  years.reserve(kChunkSize);
+  for (const YearRange& range : ranges) {
+    forEachYear(range, [&](Year y) {
+      years.push_back(y);
+      if (years.size() == kChunkSize) { submit(years); }
+    });
+  }
+  if (!years.empty()) { submit(years); }
+  while (!pending.empty()) { printFront(); }
+} // CliController::calculateParallel(const std::vector<Job>&, ...) const
+
+void CliController::calculateSearch(const std::vector<Job>& jobs,
+                                    const ICalculationMethod& pascha,
+                                    const CalculationOptions& options,
+                                    const std::vector<YearRange>& ranges,
+                                    bool arrow, bool byzantine) const
+{
+  // How to find the years of a range in increasing order, and the last year
+  // that can be found. A number of weeks between the calendars is only found
+  // in a few thousand years, so a backwards range is searched all at once, and
+  // otherwise in windows from its end, each of which is reversed.
+  using Visit = std::function<void(Year)>;
+  std::function<void(Year, Year, const Visit&)> find{};
+  Year last{std::numeric_limits<Year>::max()};
+  Year window{std::numeric_limits<Year>::max()};
+  std::optional<PaschaIndex> index{};
+  if (options.search_weeks) {
+    find = [weeks = Weeks{*options.search_weeks}](Year from, Year to,
+                                                  const Visit& visit) {
+      forEachWeeksBetween(weeks, from, to, visit);
+    };
+  } else {
+    index.emplace(options.calculation_method, options.output_calendar);
+    find = [&index, &options](Year from, Year to, const Visit& visit) {
+      index->forEachYear(options.search_month, options.search_day, from, to,
+                         visit);
+    };
+    last = index->lastYear();
+    window = Year{1} << 20;
+  }
+
+  // The years found are calculated in blocks as they are found, except for
+  // the Arrow format, which is written from all of them at once.
+  constexpr std::size_t kBlockSize{4096};
+  std::vector<Year> block{};
+  std::vector<YearRange> found{};
+  auto add{[&](Year year) {
+    if (arrow) {
+      found.push_back(YearRange{year, year});
+      return;
+    }
+    block.push_back(year);
+    if (block.size() == kBlockSize) {
+      calculateYears(jobs, pascha, block, *m_model, true);
+      block.clear();
+    }
+  }};
+
+  // The index can not find the years before kGregorianMinYear that the
+  // Gregorian computus gives, so a range that reaches them is an error for
+  // those years rather than a shorter answer.
+  const std::string earlier{"Years before " +
+                            std::to_string(kGregorianMinYear) +
+                            " can not be searched"};
+  std::vector<Year> window_years{};
+  for (const YearRange& range : ranges) {
+    if (index && index->hasEarlierYears() &&
+        std::min(range.from, range.to) < kGregorianMinYear) {
+      m_model->notify(std::string_view{earlier});
+    }
+    auto step{static_cast<std::uint64_t>(range.step)};
+    if (range.from <= range.to) {
+      find(range.from, range.to, [&](Year year) {
+        if ((static_cast<std::uint64_t>(year) -
+             static_cast<std::uint64_t>(range.from)) %
+                step ==
+            0) {
+          add(year);
+        }
+      });
+      continue;
+    }
+    // Only the years that can be found are searched.
+    Year high{std::min(range.from, last)};
+    Year end{std::max(range.to, Year{kGregorianMinYear})};
+    while (high >= end) {
+      Year low{static_cast<std::uint64_t>(high) -
+                           static_cast<std::uint64_t>(end) <
+                       static_cast<std::uint64_t>(window)
+                   ? end
+                   : high - window + 1};
+      window_years.clear();
+      find(low, high,
+           [&window_years](Year year) { window_years.push_back(year); });
+      for (auto year{window_years.rbegin()}; year != window_years.rend();
+           ++year) {
+        if ((static_cast<std::uint64_t>(range.from) -
+             static_cast<std::uint64_t>(*year)) %
+                step ==
+            0) {
+          add(*year);
         }
       }
+      if (low == end) { break; }
+      high = low - 1;
     }
+  }
 
-    // 5. Set the calculation method and calculate.
-    m_model->setCalculationMethod(std::move(method));
-    m_model->calculate(year);
+  if (arrow) {
+    calculateArrow(jobs, found, options.output_calendar, byzantine);
+  } else if (!block.empty()) {
+    calculateYears(jobs, pascha, block, *m_model, true);
   }
+} // CliController::calculateSearch(const std::vector<Job>&, ...) const
 
-} // CliController::calculate(const CalculationOptions&) const
+void CliController::calculateStatistics(const CalculationOptions& options,
+                                        const std::vector<YearRange>& ranges,
+                                        bool byzantine) const
+{
+  using namespace std::literals; // for sv
+
+  for (const YearRange& range : ranges) {
+    if (range.step != 1) {
+      m_model->notify("Statistics can not be calculated with a step"sv);
+      return;
+    }
+  }
+
+  // The dates are printed for the first year with each, through the pipeline
+  // of the output, so that they are printed as any other date is.
+  PaschaIndex index{options.calculation_method, options.output_calendar};
+  const std::string earlier{"Statistics can not be calculated for years "
+                            "before " +
+                            std::to_string(kGregorianMinYear)};
+  std::shared_ptr<ICalculationMethod> pascha{
+      makeStaticPipeline(options.calculation_method, e_target_output::pascha,
+                         options.output_calendar, byzantine)};
+
+  for (const YearRange& range : ranges) {
+    Year from{std::min(range.from, range.to)};
+    Year to{std::max(range.from, range.to)};
+    if (index.hasEarlierYears() && from < kGregorianMinYear) {
+      m_model->notify(std::string_view{earlier});
+    }
+    PaschaStatistics statistics{index.statistics(from, to)};
+    *m_out << "Years: " << statistics.years << '\n';
+    if (statistics.years == 0) { continue; }
+
+    *m_out << "Earliest: ";
+    m_model->notify(pascha->calculate(statistics.earliest));
+    *m_out << "Latest: ";
+    m_model->notify(pascha->calculate(statistics.latest));
+    for (const PaschaStatistics::DateCount& count : statistics.dates) {
+      *m_out << count.years << ": ";
+      m_model->notify(pascha->calculate(count.first));
+    }
+
+    WeeksBetweenStatistics weeks{weeksBetweenStatistics(from, to)};
+    if (weeks.years == 0) { continue; }
+    std::ostringstream mean{};
+    mean << std::fixed << std::setprecision(4) << weeks.mean;
+    *m_out << "Mean weeks between calendars: " << mean.str() << '\n'
+           << "Least weeks between calendars: ";
+    m_model->notify(weeks.least);
+    *m_out << "Most weeks between calendars: ";
+    m_model->notify(weeks.most);
+    forEachWeeksCount(
+        from, to, [this](const WeeksBetweenStatistics::WeeksCount& count) {
+          *m_out << count.years << ": " << count.weeks.value << " weeks from "
+                 << count.first << '\n';
+        });
+  }
+} // CliController::calculateStatistics(const CalculationOptions&, ...) const
+
+void CliController::calculateArrow(const std::vector<Job>& jobs,
+                                   const std::vector<YearRange>& ranges,
+                                   EOutputCalendar calendar,
+                                   bool byzantine) const
+{
+  using namespace std::literals; // for sv
+
+  for (const Job& job : jobs) {
+    if (job.target == e_target_output::daysUntil ||
+        job.target == e_target_output::weeksBetween) {
+      m_model->notify("Only dates can be written in the Arrow format"sv);
+      return;
+    }
+  }
+
+  std::string calendar_name{calendarName(calendar)};
+  if (byzantine) { calendar_name += "_anno_mundi"; }
+
+  // Each record batch holds every job for a block of years, in the same order
+  // as the text output. Years that can not be calculated are left out, with
+  // their errors notified as usual.
+  constexpr std::size_t kBatchYears{65536};
+  std::vector<Year> years{};
+  years.reserve(kBatchYears);
+  std::vector<Date> dates(jobs.size() * kBatchYears);
+  std::vector<EConversionError> errors(jobs.size() * kBatchYears);
+  ArrowWriter writer{*m_out};
+
+  auto writeBatch{[&] {
+    for (std::size_t j{0}; j < jobs.size(); ++j) {
+      std::span<Date> job_dates{&dates[j * kBatchYears], years.size()};
+      std::span<EConversionError> job_errors{&errors[j * kBatchYears],
+                                             years.size()};
+      std::fill(job_errors.begin(), job_errors.end(),
+                e_conversion_error::none);
+      if (jobs[j].method->tryCalculate(years, job_dates, job_errors) == 0) {
+        continue;
+      }
+      for (EConversionError error : job_errors) {
+        if (error != e_conversion_error::none) {
+          m_model->notify(conversionErrorMessage(error));
+        }
+      }
+    }
+
+    for (std::size_t i{0}; i < years.size(); ++i) {
+      for (std::size_t j{0}; j < jobs.size(); ++j) {
+        std::size_t index{j * kBatchYears + i};
+        if (errors[index] != e_conversion_error::none) { continue; }
+        Checked<CalcInt> jdn{outputJdn(dates[index], calendar, byzantine)};
+        if (!jdn) {
+          m_model->notify(conversionErrorMessage(jdn.error));
+          continue;
+        }
+        writer.append(dates[index], targetName(jobs[j].target), calendar_name,
+                      *jdn);
+      }
+    }
+    writer.writeBatch();
+    years.clear();
+  }};
+
+  for (const YearRange& range : ranges) {
+    forEachYear(range, [&](Year y) {
+      years.push_back(y);
+      if (years.size() == kBatchYears) { writeBatch(); }
+    });
+  }
+  if (!years.empty()) { writeBatch(); }
+  writer.finish();
+} // CliController::calculateArrow(const std::vector<Job>&, ...) const
+
+void CliController::calculateYear(const std::vector<Job>& jobs, Year year,
+                                  bool given_year, ICalculatorModel& model,
+                                  bool print_labels) const
+{
+  for (const Job& job : jobs) {
+    if (print_labels) { *m_out << job.label; }
+    calculateJob(job, year, given_year, model);
+  }
+} // CliController::calculateYear(const std::vector<Job>&, Year, ...) const
+
+void CliController::calculateJob(const Job& job, Year year, bool given_year,
+                                 ICalculatorModel& model) const
+{
+  switch (job.target) {
+    case e_target_output::weeksBetween: {
+      model.weeksBetween(year, job.method, job.other_method);
+      break;
+    }
+    case e_target_output::daysUntil: {
+      model.setCalculationMethod(job.method);
+
+      // Without a given year, count to next year's Pascha once this year's
+      // has passed.
+      Result<Days> days{model.calculateDaysUntil(year)};
+      if (!given_year && days && days->value < 0) {
+        days = model.calculateDaysUntil(year + 1);
+      }
+      if (days) {
+        model.notify(*days);
+      } else {
+        model.notify(days.message());
+      }
+      break;
+    }
+    default: {
+      model.setCalculationMethod(job.method);
+      model.calculate(year);
+      break;
+    }
+  }
+} // CliController::calculateJob(const Job&, Year, bool, ICalculatorModel&)
 
 void CliController::addView(IView& view)
 {
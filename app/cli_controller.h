@@ -22,6 +22,14 @@
 #define PASCHA_CLI_CONTROLLER_H
 
 #include "pascha/i_controller.h"
+#include "pascha/static_pipeline.h"
+
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
 namespace pascha
 {
 
@@ -38,12 +46,64 @@ class CliController : public IController
   virtual void addView(IView&) override;
   virtual void removeView(IView&) override;
   virtual void start() override;
+  // Write the labels, statistics and Arrow streams to out rather than to
+  // std::cout, as the view does with the results it observes.
+  void setOutput(std::ostream& out) { m_out = &out; }
 
  private:
+  // A requested target output with the calculation method that produces it.
+  // These are built once per call to calculate and reused for every year.
+  struct Job
+  {
+    ETargetOutput target;
+    std::string label;
+    std::shared_ptr<ICalculationMethod> method;
+    // Only used for the weeks between, as the method compared against.
+    std::shared_ptr<ICalculationMethod> other_method;
+    // For a date, derives it from the date of Pascha in the same year.
+    PipelineFinish finish{nullptr};
+  }; // struct Job
+
   ICalculatorModel* m_model{};
   std::vector<IView*> m_views{};
+  std::ostream* m_out{&std::cout};
 
   bool validateYear(const Year& year) const;
+  // Calculate every job for the year through the given model, printing the
+  // label of each job before it when print_labels is set.
+  void calculateYear(const std::vector<Job>& jobs, Year year, bool given_year,
+                     ICalculatorModel& model, bool print_labels) const;
+  void calculateJob(const Job& job, Year year, bool given_year,
+                    ICalculatorModel& model) const;
+  // Calculate every job for each of the given years, in year order. The date
+  // of Pascha is calculated once per year by the pascha method, and each date
+  // is derived from it.
+  void calculateYears(const std::vector<Job>& jobs,
+                      const ICalculationMethod& pascha,
+                      std::span<const Year> years, ICalculatorModel& model,
+                      bool print_labels) const;
+  // As calculateYears for all of the ranges, splitting them into chunks that
+  // are calculated on a pool of threads and printed in order.
+  void calculateParallel(const std::vector<Job>& jobs,
+                         const ICalculationMethod& pascha,
+                         const std::vector<YearRange>& ranges,
+                         std::size_t threads) const;
+  // As calculateYears for the years in the ranges whose Pascha falls on the
+  // month and day searched for in options, found through a PaschaIndex.
+  void calculateSearch(const std::vector<Job>& jobs,
+                       const ICalculationMethod& pascha,
+                       const CalculationOptions& options,
+                       const std::vector<YearRange>& ranges, bool arrow,
+                       bool byzantine) const;
+  // Print how often Pascha falls on each date over each of the ranges, and the
+  // weeks between the Julian and Gregorian dates.
+  void calculateStatistics(const CalculationOptions& options,
+                           const std::vector<YearRange>& ranges,
+                           bool byzantine) const;
+  // Write the dates for every year in the ranges as an Arrow IPC stream.
+  void calculateArrow(const std::vector<Job>& jobs,
+                      const std::vector<YearRange>& ranges,
+                      EOutputCalendar calendar, bool byzantine) const;
 }; // class CliController
 
 } // namespace pascha
@@ -19,12 +19,106 @@
 // reporting.
 
 #include "cli_view.h"
+#include "http_server.h"
+#include "output_buffer.h"
 #include "pascha/calculation_options.h"
+#include "pascha/calendar_conversion.h"
+#include "query_server.h"
 
-#include <getopt.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <iomanip>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
+
+namespace
+{
+using namespace pascha;
+
+// Write an integer in decimal straight to the buffer, as operator<< would.
+void putNumber(std::streambuf& out, std::int64_t value)
+{
+  std::array<char, 24> digits{};
+  auto [end, ec] = std::to_chars(digits.begin(), digits.end(), value);
+  out.sputn(digits.data(), end - digits.begin());
+} // putNumber
+
+// Whether a query read from a line may use the options given in it, which
+// must not start another mode or write anything but text.
+bool isLineQuery(const Query& query)
+{
+  bool arrow{std::find(query.options.options.begin(),
+                       query.options.options.end(),
+                       e_output_option::arrow) != query.options.options.end()};
+  return !query.help && !arrow && query.serve.empty() &&
+         query.connect.empty() && query.http.empty() && !query.read_stdin;
+} // isLineQuery
+
+// The most years of a query for --serve calculated at a time, or searched for
+// a date, where at most a few percent are found. The years of a search for a
+// number of weeks are found in a few thousand years of each range, and the
+// statistics of a range are counted at once, so those are calculated a range
+// at a time.
+constexpr std::uint64_t kQueryBlockYears{4096};
+constexpr std::uint64_t kQuerySearchYears{1 << 16};
+// The most years of a range of which the statistics are counted for a query,
+// so that each takes little time and gives a bounded response.
+constexpr Year kQueryMaxStatisticsYears{1'000'000};
+
+// Take up to size of the years of the ranges, from the year next of the range
+// at index range, as ranges into block, moving next past them. Returns
+// whether there are more years after them. The years of a search before
+// kGregorianMinYear, which are not searched but reported as an error, are
+// taken together so that the error is only reported once for each range.
+bool nextBlock(const std::vector<YearRange>& ranges, std::size_t& range,
+               Year& next, std::uint64_t size, bool search,
+               std::vector<YearRange>& block)
+{
+  block.clear();
+  std::uint64_t count{0};
+  while (true) {
+    // The distance to the end of the range is computed unsigned so that
+    // ranges reaching the limits of Year do not overflow.
+    const YearRange& current{ranges[range]};
+    auto step{static_cast<std::uint64_t>(current.step)};
+    bool up{current.from <= current.to};
+    auto unsignedNext{static_cast<std::uint64_t>(next)};
+    std::uint64_t left{(up ? static_cast<std::uint64_t>(current.to) -
+                                 unsignedNext
+                           : unsignedNext -
+                                 static_cast<std::uint64_t>(current.to)) /
+                       step};
+    std::uint64_t take{std::min(left, size - count - 1)};
+    if (search && up && next < kGregorianMinYear) {
+      take = std::max(
+          take, std::min(left, (static_cast<std::uint64_t>(kGregorianMinYear) -
+                                unsignedNext - 1) /
+                                   step));
+    }
+    auto last{static_cast<Year>(up ? unsignedNext + take * step
+                                   : unsignedNext - take * step)};
+    if (search && !up && last < kGregorianMinYear) {
+      take = left;
+      last = static_cast<Year>(unsignedNext - take * step);
+    }
+    block.push_back(YearRange{next, last, current.step});
+    count += take + 1;
+    if (take < left) {
+      next = static_cast<Year>(up ? static_cast<std::uint64_t>(last) + step
+                                  : static_cast<std::uint64_t>(last) - step);
+      return true;
+    }
+    if (++range == ranges.size()) { return false; }
+    next = ranges[range].from;
+    if (count >= size) { return true; }
+  }
+} // nextBlock
+
+} // anonymous namespace
 
 namespace pascha
 {
@@ -34,12 +128,21 @@ CliView::CliView(IController& controller, ICalculatorModel& model, int argc,
       m_model{model},
       m_argc{argc},
       m_argv{argv},
+      m_default_separator{date_separator},
       m_date_separator{date_separator}
 {
   m_model.addObserver(*this);
   // m_controller.addView(*this);
 } // CliView::CliView()
 
+CliView::CliView(CliController& controller, ICalculatorModel& model,
+                 int argc, char* argv[], std::string_view date_separator)
+    : CliView{static_cast<IController&>(controller), model, argc, argv,
+              date_separator}
+{
+  m_cli_controller = &controller;
+} // CliView::CliView(CliController&, ...)
+
 CliView::~CliView()
 {
   m_model.removeObserver(*this);
@@ -48,137 +151,366 @@ CliView::~CliView()
 
 void CliView::createView()
 {
-  CalculationOptions options = parseArgs(m_argc, m_argv);
-  m_controller.calculate(options);
+  std::vector<std::string_view> args(m_argv + 1, m_argv + m_argc);
+  Query query{};
+  std::string error{};
+  if (!parseQuery(args, query, error)) {
+    std::cerr << "Error: " << error << '\n';
+    printUsage(m_argv);
+    exit(EXIT_FAILURE);
+  }
+  if (query.help) {
+    printUsage(m_argv);
+    exit(EXIT_SUCCESS);
+  }
+
+  if (!query.connect.empty()) {
+    // Send the other options as the query, or read queries from stdin if there
+    // are none.
+    std::vector<std::string_view> query_args{};
+    for (std::size_t i{0}; i < args.size(); ++i) {
+      if (args[i] == "--connect") {
+        ++i;
+      } else if (!args[i].starts_with("--connect=")) {
+        query_args.push_back(args[i]);
+      }
+    }
+    if (!sendQueries(query.connect, query_args, error)) {
+      std::cerr << "Error: " << error << '\n';
+      exit(EXIT_FAILURE);
+    }
+    return;
+  }
+  if (!query.http.empty()) {
+    if (!serveHttp(query.http, query.options.threads, error)) {
+      std::cerr << "Error: " << error << '\n';
+      exit(EXIT_FAILURE);
+    }
+    return;
+  }
+  if (!query.serve.empty()) {
+    if (!serveQueries(
+            query.serve,
+            [this](std::string_view line) { return answerQuery(line); },
+            error)) {
+      std::cerr << "Error: " << error << '\n';
+      exit(EXIT_FAILURE);
+    }
+    return;
+  }
+
+  if (query.read_stdin) {
+    std::vector<std::string_view> base_args{};
+    std::copy_if(args.begin(), args.end(), std::back_inserter(base_args),
+                 [](std::string_view arg) { return arg != "--stdin"; });
+    Query base{};
+    parseQuery(base_args, base, error);
+    if (!isLineQuery(base)) {
+      std::cerr << "Error: Option not supported with --stdin\n";
+      exit(EXIT_FAILURE);
+    }
+    answerStdin(base_args);
+    return;
+  }
+
+  configure(query);
+  OutputBuffer buffer{std::cout};
+  m_controller.calculate(query.options);
 
 } // CliView::createView()
 
 void CliView::update(const Date& date)
 {
-  std::cout << std::setfill('0') << std::setw(2) << date.month
-            << m_date_separator << std::setfill('0') << std::setw(2)
-            << date.day;
-  if (!m_suppress_year && m_given_year) {
-    std::cout << m_date_separator << date.year;
+  std::streambuf& out{*m_out->rdbuf()};
+  if (date.month >= 1 && date.month <= 12 && date.day >= 1 && date.day <= 31) {
+    std::size_t index{static_cast<std::size_t>((date.month - 1) * 31 +
+                                               (date.day - 1))};
+    out.sputn(&m_month_days[index * m_month_day_width],
+              static_cast<std::streamsize>(m_month_day_width));
+  } else {
+    *m_out << std::setfill('0') << std::setw(2) << date.month
+           << m_date_separator << std::setfill('0') << std::setw(2) << date.day;
   }
-  std::cout << '\n';
+  if (m_print_year) {
+    out.sputn(m_date_separator.data(),
+              static_cast<std::streamsize>(m_date_separator.size()));
+    putNumber(out, date.year);
+  }
+  out.sputc('\n');
 } // CliView::update(const Date&)
 
+void CliView::update(std::span<const Date> dates,
+                     const DatesMetadata& metadata)
+{
+  auto inGrid{[](const Date& date) {
+    return date.month >= 1 && date.month <= 12 && date.day >= 1 &&
+           date.day <= 31;
+  }};
+  if (!std::all_of(dates.begin(), dates.end(), inGrid)) {
+    IView::update(dates, metadata);
+    return;
+  }
+
+  // Each line is at most the month and day, the separator and a year of up to
+  // 20 characters, and a newline.
+  constexpr std::size_t kMaxYearWidth{20};
+  std::size_t width{m_month_day_width + 1};
+  if (m_print_year) { width += m_date_separator.size() + kMaxYearWidth; }
+  m_block.resize(dates.size() * width);
+
+  char* entry{m_block.data()};
+  for (const Date& date : dates) {
+    std::size_t index{static_cast<std::size_t>((date.month - 1) * 31 +
+                                               (date.day - 1))};
+    entry = std::copy_n(&m_month_days[index * m_month_day_width],
+                        m_month_day_width, entry);
+    if (m_print_year) {
+      entry = std::copy(m_date_separator.begin(), m_date_separator.end(),
+                        entry);
+      entry = std::to_chars(entry, entry + kMaxYearWidth, date.year).ptr;
+    }
+    *entry++ = '\n';
+  }
+  m_out->rdbuf()->sputn(m_block.data(), entry - m_block.data());
+} // CliView::update(std::span<const Date>, const DatesMetadata&)
+
 void CliView::update(Weeks weeks)
 {
-  std::cout << weeks.value << '\n';
+  std::streambuf& out{*m_out->rdbuf()};
+  putNumber(out, weeks.value);
+  out.sputc('\n');
 } // CliView::update(Weeks)
 
 void CliView::update(Days days)
 {
-  std::cout << days.value << '\n';
+  std::streambuf& out{*m_out->rdbuf()};
+  putNumber(out, days.value);
+  out.sputc('\n');
 } // CliView::update(Days)
 
 void CliView::update(std::string_view message)
 {
-  std::cerr << "Error: " << message << '\n';
+  // std::cerr is tied to std::cout, so the dates before the error are written
+  // out first.
+  *m_err << "Error: " << message << '\n';
 } // CliView::update(std::string_view)
 
-CalculationOptions CliView::parseArgs(int argc, char* argv[])
-{
-  int opt{};
-  CalculationOptions options{};
-  m_year = -9223372036854775807; // indicates no year given
-
-  while ((opt = getopt(argc, argv, ":jgJRGbsdDmcaMlApxXvVs:y:h")) != -1) {
-    switch (opt) {
-      case 'j':
-        options.calculation_method = e_calculation_method::julian;
-        break;
-      case 'g':
-        options.calculation_method = e_calculation_method::gregorian;
-        options.output_calendar = e_output_calendar::gregorian;
-        break;
-      case 'J': options.output_calendar = e_output_calendar::julian; break;
-      case 'R': options.output_calendar = e_output_calendar::rev_julian; break;
-      case 'G': options.output_calendar = e_output_calendar::gregorian; break;
-      case 'b': options.options.push_back(e_output_option::byzantine); break;
-      case 's': m_suppress_year = true; break;
-      case 'd': m_days_until = true; break;
-      case 'D': m_weeks_between = true; break;
-      case 'm': m_meatfare = true; break;
-      case 'c': m_cheesefare = true; break;
-      case 'a': m_ash_wednesday = true; break;
-      case 'M': m_midfeast = true; break;
-      case 'l': m_leavetaking = true; break;
-      case 'A': m_ascension = true; break;
-      case 'p': m_pentecost = true; break;
-      case 'x': m_suppress_pascha = true; break;
-      case 'X':
-        m_chronological = true;
-        m_suppress_pascha = true;
-        break;
-      case 'v': options.options.push_back(e_output_option::verbose); break;
-      case 'V':
-        options.options.push_back(e_output_option::verbose);
-        options.options.push_back(e_output_option::easter);
-        break;
-      case 'S': m_date_separator = optarg; break;
-      case 'y':
-        try {
-          m_year = Year{std::stoi(optarg)};
-          m_given_year = true;
-        } catch (std::invalid_argument& e) {
-          std::cerr << "Error: Invalid year: " << optarg << '\n';
-          printUsage(argv);
-          exit(EXIT_FAILURE);
-        }
-        break;
-      case 'h': printUsage(argv); exit(EXIT_SUCCESS);
-      case ':': printUsage(argv); exit(EXIT_FAILURE);
-      case '?': printUsage(argv); exit(EXIT_FAILURE);
-      default: printUsage(argv); exit(EXIT_FAILURE);
-    }
-  }
-
-  if (!m_suppress_pascha) {
-    options.target_outputs.push_back(e_target_output::pascha);
-  }
-  if (m_days_until) {
-    options.target_outputs.push_back(e_target_output::daysUntil);
-  }
-  if (m_weeks_between) {
-    options.target_outputs.push_back(e_target_output::weeksBetween);
-  }
-  if (m_meatfare) {
-    options.target_outputs.push_back(e_target_output::meatfare);
-  }
-  if (m_cheesefare) {
-    options.target_outputs.push_back(e_target_output::cheesefare);
-  }
-  if (m_ash_wednesday) {
-    options.target_outputs.push_back(e_target_output::ashWednesday);
-  }
-  if (m_chronological) {
-    options.target_outputs.push_back(e_target_output::pascha);
-  }
-  if (m_midfeast) {
-    options.target_outputs.push_back(e_target_output::midfeastPentecost);
-  }
-  if (m_leavetaking) {
-    options.target_outputs.push_back(e_target_output::leavetakingPascha);
-  }
-  if (m_ascension) {
-    options.target_outputs.push_back(e_target_output::ascension);
-  }
-  if (m_pentecost) {
-    options.target_outputs.push_back(e_target_output::pentecost);
-  }
-
-  options.year = m_year;
-  return options;
-} // parseArgs(int, char*[])
+void CliView::configure(const Query& query)
+{
+  m_date_separator = query.date_separator.value_or(m_default_separator);
+  m_print_year = query.print_year;
+  formatMonthDays();
+} // CliView::configure(const Query&)
+
+QueryResponse CliView::answerQuery(std::string_view line)
+{
+  auto error{[](std::string message) -> QueryResponse {
+    return [message = std::move(message)](std::string& out) {
+      out += "Error: ";
+      out += message;
+      out += '\n';
+      return false;
+    };
+  }};
+  std::vector<std::string_view> args{splitQuery(line)};
+  auto stream{std::make_shared<QueryStream>()};
+  std::string message{};
+  if (!parseQuery(args, stream->query, message, true)) {
+    return error(std::move(message));
+  }
+  if (!isLineQuery(stream->query)) {
+    return error("Option not supported in a query");
+  }
+
+  // A block is too small to share among threads, and the output is the same
+  // without them.
+  CalculationOptions& options{stream->query.options};
+  options.threads = 1;
+  if (options.statistics) {
+    for (const YearRange& range : options.years) {
+      auto [low, high]{std::minmax(range.from, range.to)};
+      if (static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low) >=
+          static_cast<std::uint64_t>(kQueryMaxStatisticsYears)) {
+        return error("Statistics of more than " +
+                     std::to_string(kQueryMaxStatisticsYears) +
+                     " years can not be calculated in a query");
+      }
+    }
+  }
+  if (!options.years.empty()) { stream->next = options.years.front().from; }
+  return [this, stream](std::string& out) {
+    return answerBlock(*stream, out);
+  };
+} // CliView::answerQuery(std::string_view)
+
+bool CliView::answerBlock(QueryStream& stream, std::string& out)
+{
+  // The output of the block, and the errors in order with it, are written
+  // into the response through the view and the controller.
+  StringBuffer buffer{out};
+  std::ostream response{&buffer};
+  m_out = &response;
+  m_err = &response;
+  if (m_cli_controller) { m_cli_controller->setOutput(response); }
+
+  const CalculationOptions& options{stream.query.options};
+  CalculationOptions block{options};
+  bool more{false};
+  if (!options.years.empty()) {
+    if (options.statistics || options.search_weeks) {
+      block.years.assign(1, options.years[stream.range]);
+      more = ++stream.range < options.years.size();
+    } else {
+      bool search{options.search_month != 0};
+      more = nextBlock(options.years, stream.range, stream.next,
+                       search ? kQuerySearchYears : kQueryBlockYears, search,
+                       block.years);
+    }
+    block.year = block.years.front().from;
+  }
+  try {
+    configure(stream.query);
+    m_controller.calculate(block);
+  } catch (const std::exception& e) {
+    response << "Error: " << e.what() << '\n';
+    more = false;
+  }
+
+  m_out = &std::cout;
+  m_err = &std::cerr;
+  if (m_cli_controller) { m_cli_controller->setOutput(std::cout); }
+  return more;
+} // CliView::answerBlock(QueryStream&, std::string&)
+
+void CliView::answerStdin(const std::vector<std::string_view>& args)
+{
+  // A line which is only a year is calculated with the options of the command
+  // line, as if given with -y. Runs of such lines are calculated together as a
+  // list of years, so that the controller builds its jobs once per run rather
+  // than once per line.
+  constexpr std::size_t kRunSize{4096};
+  constexpr std::string_view kSpace{" \t\r\n\v\f"};
+  std::vector<std::string_view> year_args{args};
+  year_args.push_back("-y");
+  year_args.push_back("0");
+  Query years{};
+  std::string error{};
+  parseQuery(year_args, years, error);
+  years.options.years.clear();
+  bool configured{false};
+
+  auto calculateYears{[&] {
+    if (years.options.years.empty()) { return; }
+    if (!configured) {
+      configure(years);
+      configured = true;
+    }
+    years.options.year = years.options.years.front().from;
+    m_controller.calculate(years.options);
+    years.options.years.clear();
+  }};
+
+  auto answerLine{[&](std::string_view line) {
+    std::size_t start{std::min(line.find_first_not_of(kSpace), line.size())};
+    std::size_t end{line.find_last_not_of(kSpace) + 1};
+    Year year{};
+    if (start < end && parseYear(line.substr(start, end - start), year)) {
+      years.options.years.push_back(YearRange{year, year});
+      if (years.options.years.size() == kRunSize) { calculateYears(); }
+      return;
+    }
+    calculateYears();
+    if (start >= end) { return; }
+
+    std::vector<std::string_view> query_args{args};
+    for (std::string_view arg : splitQuery(line)) {
+      query_args.push_back(arg);
+    }
+    Query query{};
+    if (!parseQuery(query_args, query, error, true)) {
+      std::cerr << "Error: " << error << '\n';
+      return;
+    }
+    if (!isLineQuery(query)) {
+      std::cerr << "Error: Option not supported in a query\n";
+      return;
+    }
+    configure(query);
+    configured = false;
+    m_controller.calculate(query.options);
+  }};
+
+  // Read stdin in blocks straight from its buffer, which does not flush
+  // std::cout as reading through std::cin would.
+  OutputBuffer buffer{std::cout};
+  std::streambuf& in{*std::cin.rdbuf()};
+  std::vector<char> block(OutputBuffer::kSize);
+  std::string partial{};
+  std::streamsize count{};
+  while ((count = in.sgetn(block.data(),
+                           static_cast<std::streamsize>(block.size()))) > 0) {
+    std::string_view text{block.data(), static_cast<std::size_t>(count)};
+    std::size_t newline{};
+    while ((newline = text.find('\n')) != std::string_view::npos) {
+      if (partial.empty()) {
+        answerLine(text.substr(0, newline));
+      } else {
+        partial += text.substr(0, newline);
+        answerLine(partial);
+        partial.clear();
+      }
+      text.remove_prefix(newline + 1);
+    }
+    partial += text;
+  }
+  if (!partial.empty()) { answerLine(partial); }
+  calculateYears();
+} // CliView::answerStdin(const std::vector<std::string_view>&)
+
+void CliView::formatMonthDays()
+{
+  m_month_day_width = 4 + m_date_separator.size();
+  m_month_days.resize(12 * 31 * m_month_day_width);
+
+  auto entry{m_month_days.begin()};
+  for (int month{1}; month <= 12; ++month) {
+    for (int day{1}; day <= 31; ++day) {
+      *entry++ = static_cast<char>('0' + month / 10);
+      *entry++ = static_cast<char>('0' + month % 10);
+      entry = std::copy(m_date_separator.begin(), m_date_separator.end(), entry);
+      *entry++ = static_cast<char>('0' + day / 10);
+      *entry++ = static_cast<char>('0' + day % 10);
+    }
+  }
+} // CliView::formatMonthDays()
 
 void CliView::printUsage(char* argv[]) const
 {
   std::cout
       << "Usage: " << argv[0]
-      << " [-j|-g] [-J|-R|-G] [-bsdDmcaMlApxXvV] [-s <SEP>] [-y <YEAR>]\n";
+      << " [-j|-g] [-J|-R|-G] [-bsdDmcaMlApxXvV] [-S <SEP>] [-y <YEARS>]"
+         " [--on <MM-DD>|--weeks <N>|--stats]\n"
+         "       [--jobs <N>] [--format text|arrow]"
+         " [--serve <SOCKET>|--connect <SOCKET>]\n"
+         "       [--http [HOST:]PORT] [--stdin]\n"
+      << "  YEARS is a comma separated list of YEAR, FROM..TO, or "
+         "FROM..TO:STEP\n"
+      << "  --on only calculates the YEARS, or the next 100 years, whose\n"
+         "    Pascha falls on month MM and day DD\n"
+      << "  --weeks only calculates the YEARS, or the next 100 years, whose\n"
+         "    Julian Pascha is N weeks after Gregorian Pascha\n"
+      << "  --stats counts the YEARS, or the next 100 years, by their date\n"
+         "    of Pascha and the weeks between calendars\n"
+      << "  --jobs calculates YEARS on N threads, or one per core if N is 0\n"
+      << "  --format arrow writes the dates as an Apache Arrow IPC stream\n"
+      << "  --serve answers queries of the other options, one per line, on\n"
+         "    the Unix domain socket SOCKET\n"
+      << "  --connect sends the other options as a query to the server on\n"
+         "    SOCKET, or each line of stdin if there are none\n"
+      << "  --http answers HTTP requests for dates as JSON on PORT of HOST,\n"
+         "    or of 127.0.0.1, with one worker thread for each of --jobs\n"
+      << "  --stdin calculates each line of stdin, a year or options, with\n"
+         "    the other options\n";
 } // printUsage(char*[])
 
 } // namespace pascha
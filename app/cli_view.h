@@ -21,11 +21,18 @@
 #ifndef PASCHA_CLIVIEW_H
 #define PASCHA_CLIVIEW_H
 
+#include "cli_controller.h"
 #include "pascha/i_calculator_model.h"
 #include "pascha/i_controller.h"
 #include "pascha/i_view.h"
+#include "query.h"
+#include "query_server.h"
 
+#include <iostream>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace pascha
 {
@@ -35,6 +42,10 @@ class CliView : public IView
  public:
   CliView(IController& controller, ICalculatorModel& model, int argc,
           char* argv[], std::string_view date_separator = "-");
+  // The output of a CliController is also written into the response of each
+  // query for --serve.
+  CliView(CliController& controller, ICalculatorModel& model, int argc,
+          char* argv[], std::string_view date_separator = "-");
   ~CliView();
 
   // IView interface
@@ -45,42 +56,53 @@ class CliView : public IView
   void update(Weeks weeks) override;
   void update(Days days) override;
   void update(std::string_view message) override;
+  void update(std::span<const Date> dates,
+              const DatesMetadata& metadata) override;
 
  private:
+  // A query being answered for --serve, with the years still to calculate.
+  struct QueryStream
+  {
+    Query query{};
+    std::size_t range{0};
+    Year next{};
+  }; // struct QueryStream
+
   IController& m_controller;
+  CliController* m_cli_controller{};
   ICalculatorModel& m_model;
   int m_argc;
   char** m_argv;
+  std::string m_default_separator;
   std::string m_date_separator;
-  bool m_suppress_year{false};
-  bool m_suppress_pascha{false};
-  bool m_chronological{false};
-  Year m_year{};
-  bool m_given_year{false};
-  bool m_days_until{false};
-  bool m_weeks_between{false};
-  bool m_meatfare{false};
-  bool m_cheesefare{false};
-  bool m_ash_wednesday{false};
-  bool m_midfeast{false};
-  bool m_leavetaking{false};
-  bool m_ascension{false};
-  bool m_pentecost{false};
+  // Every month and day already formatted as "MM<SEP>DD", in a row of
+  // m_month_day_width characters for each day of a 12 by 31 grid.
+  std::vector<char> m_month_days{};
+  std::size_t m_month_day_width{};
+  bool m_print_year{false};
+  // The text of a block of dates, formatted before it is written at once.
+  std::vector<char> m_block{};
+  // Where the results and the errors are written, which for --serve is the
+  // response to the query being answered.
+  std::ostream* m_out{&std::cout};
+  std::ostream* m_err{&std::cerr};
 
-  CalculationOptions parseArgs(int argc, char* argv[]);
+  // Set up the output for the query.
+  void configure(const Query& query);
+  void formatMonthDays();
+  // Start answering the query given as a line of options for --serve,
+  // returning its response, which calculates a block of its years at a time
+  // into the output of the client.
+  QueryResponse answerQuery(std::string_view line);
+  // Calculate the next block of the query, appending its output and any
+  // errors to out. Returns whether there are more years after the block.
+  bool answerBlock(QueryStream& stream, std::string& out);
+  // Calculate the queries read from stdin for --stdin, one per line, each with
+  // the options of the command line in args before its own.
+  void answerStdin(const std::vector<std::string_view>& args);
   void printUsage(char* argv[]) const;
 };
 
-namespace e_output_option
-{
-
-enum
-{
-  verbose = pascha::e_output_option::last,
-  easter,
-}; // enum
-
-} // namespace e_output_option
 //
 } // namespace pascha
 #endif // !PASCHA_CLIVIEW_H
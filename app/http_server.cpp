@@ -0,0 +1,985 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "http_server.h"
+
+#if defined(__linux__)
+#include "query.h"
+
+#include "pascha/calculation_options.h"
+#include "pascha/static_pipeline.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+using namespace pascha;
+
+#if defined(__linux__)
+
+// The longest request head accepted, so that a client can not make the server
+// buffer without limit.
+constexpr std::size_t kMaxHead{1 << 14};
+// The most input or output held for a connection. Past it, no more requests
+// are read from the client until it has read some of the responses.
+constexpr std::size_t kMaxBuffered{1 << 16};
+// The number of years of a range calculated at a time, and sent as a chunk.
+constexpr std::size_t kBlockSize{4096};
+
+// An eventfd in the event loop of every worker, which the signal handler
+// writes to so that they all stop.
+int g_stop_fd{-1};
+
+extern "C" void stopWorkers(int)
+{
+  int saved{errno};
+  std::uint64_t one{1};
+  [[maybe_unused]] ssize_t count{write(g_stop_fd, &one, sizeof(one))};
+  errno = saved;
+} // stopWorkers
+
+// The message for the error of the last system call.
+std::string systemError(std::string_view what)
+{
+  std::string error{what};
+  error += ": ";
+  error += std::strerror(errno);
+  return error;
+} // systemError
+
+// The target dates by their names in requests and responses.
+constexpr std::array<std::pair<std::string_view, ETargetOutput>, 8> kTargets{{
+    {"pascha", e_target_output::pascha},
+    {"meatfare", e_target_output::meatfare},
+    {"cheesefare", e_target_output::cheesefare},
+    {"ash_wednesday", e_target_output::ashWednesday},
+    {"midfeast_of_pentecost", e_target_output::midfeastPentecost},
+    {"leavetaking_of_pascha", e_target_output::leavetakingPascha},
+    {"ascension", e_target_output::ascension},
+    {"pentecost", e_target_output::pentecost},
+}};
+
+// The options of a request, with the pipeline that calculates them.
+struct Calculation
+{
+  ECalculationMethod method{e_calculation_method::julian};
+  EOutputCalendar calendar{e_output_calendar::julian};
+  bool byzantine{false};
+  std::vector<std::string_view> targets{};
+  std::vector<YearRange> years{};
+  // Calculates the date of Pascha in the Gregorian calendar, from which each
+  // target date is derived by its finish.
+  std::shared_ptr<ICalculationMethod> pascha{};
+  std::vector<PipelineFinish> finishes{};
+}; // struct Calculation
+
+// The years of a range still to be sent in a response, which are calculated a
+// block at a time as the client reads them.
+struct RangeStream
+{
+  Calculation calculation{};
+  std::size_t range{0};
+  Year next{};
+  bool first{true};
+  // Whether the response is sent in chunks, rather than ended by closing the
+  // connection.
+  bool chunked{true};
+}; // struct RangeStream
+
+// A connected client, with what has been read from it that is not yet a whole
+// request, and the responses not yet written to it.
+struct Connection
+{
+  std::string input{};
+  std::string output{};
+  std::size_t written{0};
+  // The bytes of the body of the last request still to be skipped.
+  std::size_t body{0};
+  std::optional<RangeStream> stream{};
+  // Whether the connection is closed once the responses are written.
+  bool closing{false};
+  // Whether the client has finished sending requests.
+  bool finished{false};
+  std::uint32_t interest{EPOLLIN};
+}; // struct Connection
+
+// Buffers reused for every block of years a worker calculates.
+struct Scratch
+{
+  std::vector<Year> years{};
+  std::vector<Date> paschas{};
+  std::vector<EConversionError> errors{};
+  std::string text{};
+}; // struct Scratch
+
+// A worker, with a listening socket and event loop of its own.
+struct Worker
+{
+  int listener{-1};
+  int events{-1};
+  std::string error{};
+}; // struct Worker
+
+struct Request
+{
+  std::string_view method{};
+  std::string_view target{};
+  bool keep_alive{true};
+  std::size_t content_length{0};
+}; // struct Request
+
+void appendNumber(std::string& out, std::int64_t value)
+{
+  std::array<char, 24> digits{};
+  auto [end, ec] = std::to_chars(digits.begin(), digits.end(), value);
+  out.append(digits.data(), end);
+} // appendNumber
+
+// Append text as a JSON string.
+void appendString(std::string& out, std::string_view text)
+{
+  constexpr std::string_view kHex{"0123456789abcdef"};
+  out += '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out += "\\u00";
+      out += kHex[static_cast<unsigned char>(c) >> 4];
+      out += kHex[static_cast<unsigned char>(c) & 0xf];
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+} // appendString
+
+void appendDate(std::string& out, const Date& date)
+{
+  out += R"({"year":)";
+  appendNumber(out, date.year);
+  out += R"(,"month":)";
+  appendNumber(out, date.month);
+  out += R"(,"day":)";
+  appendNumber(out, date.day);
+  out += '}';
+} // appendDate
+
+// Append the options of a calculation as the members of a JSON object.
+void appendOptions(std::string& out, const Calculation& calculation)
+{
+  out += R"("method":)";
+  appendString(out, calculation.method == e_calculation_method::gregorian
+                        ? "gregorian"
+                        : "julian");
+  out += R"(,"calendar":)";
+  switch (calculation.calendar) {
+    case e_output_calendar::gregorian: appendString(out, "gregorian"); break;
+    case e_output_calendar::rev_julian:
+      appendString(out, "revised_julian");
+      break;
+    default: appendString(out, "julian"); break;
+  }
+  out += R"(,"byzantine":)";
+  out += calculation.byzantine ? "true" : "false";
+} // appendOptions
+
+// Append the target dates of a year as the members of a JSON object, given the
+// date of Pascha, or the error if it could not be calculated. A target date
+// which can not be calculated is given as an object with its error.
+void appendDates(std::string& out, const Calculation& calculation, Year year,
+                 const Date& pascha, std::string_view error)
+{
+  out += R"("year":)";
+  appendNumber(out, year);
+  if (!error.empty()) {
+    out += R"(,"error":)";
+    appendString(out, error);
+    return;
+  }
+  out += R"(,"dates":{)";
+  for (std::size_t i{0}; i < calculation.targets.size(); ++i) {
+    if (i > 0) { out += ','; }
+    appendString(out, calculation.targets[i]);
+    out += ':';
+    if (Checked<Date> date{calculation.finishes[i](pascha)}) {
+      appendDate(out, *date);
+    } else {
+      out += R"({"error":)";
+      appendString(out, conversionErrorMessage(date.error));
+      out += '}';
+    }
+  }
+  out += '}';
+} // appendDates
+
+// Calculate the target dates of each of the years, appending a JSON object for
+// each to out, after a comma unless it is the first.
+void appendYears(std::string& out, const Calculation& calculation,
+                 std::span<const Year> years, Scratch& scratch, bool& first)
+{
+  // Calculate Pascha for all of the years at once, with the error of each
+  // year that can not be calculated.
+  std::vector<Date>& paschas{scratch.paschas};
+  std::vector<EConversionError>& errors{scratch.errors};
+  paschas.resize(years.size());
+  errors.assign(years.size(), e_conversion_error::none);
+  calculation.pascha->tryCalculate(years, paschas, errors);
+
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    if (!first) { out += ','; }
+    first = false;
+    out += '{';
+    appendDates(out, calculation, years[i], paschas[i],
+                conversionErrorMessage(errors[i]));
+    out += '}';
+  }
+} // appendYears
+
+// Decode the %XX escapes and + of a component of a query string. Returns false
+// if an escape is invalid.
+bool decodeComponent(std::string_view text, std::string& decoded)
+{
+  decoded.clear();
+  for (std::size_t i{0}; i < text.size(); ++i) {
+    if (text[i] == '+') {
+      decoded += ' ';
+    } else if (text[i] != '%') {
+      decoded += text[i];
+    } else {
+      unsigned char c{};
+      if (text.size() - i < 3) { return false; }
+      auto [end, ec] = std::from_chars(&text[i + 1], &text[i + 3], c, 16);
+      if (ec != std::errc{} || end != &text[i + 3]) { return false; }
+      decoded += static_cast<char>(c);
+      i += 2;
+    }
+  }
+  return true;
+} // decodeComponent
+
+// Parse the targets parameter, a comma separated list of target names.
+bool parseTargets(std::string_view text, Calculation& calculation)
+{
+  calculation.targets.clear();
+  while (true) {
+    std::string_view name{text.substr(0, text.find(','))};
+    auto target{std::find_if(kTargets.begin(), kTargets.end(),
+                             [name](const auto& t) {
+                               return t.first == name;
+                             })};
+    if (target == kTargets.end() ||
+        std::find(calculation.targets.begin(), calculation.targets.end(),
+                  name) != calculation.targets.end()) {
+      return false;
+    }
+    calculation.targets.push_back(target->first);
+
+    if (name.size() == text.size()) { return true; }
+    text.remove_prefix(name.size() + 1);
+  }
+} // parseTargets
+
+// Parse the query string of a request into calculation, which takes the
+// parameter year for a single year or years for a range, and build its
+// pipeline. Returns false with a message in error if a parameter is invalid.
+bool parseParameters(std::string_view query, bool range,
+                     Calculation& calculation, std::string& error)
+{
+  std::optional<EOutputCalendar> calendar{};
+  bool given_years{false};
+  std::string name{};
+  std::string value{};
+  while (!query.empty()) {
+    std::string_view item{query.substr(0, query.find('&'))};
+    query.remove_prefix(std::min(item.size() + 1, query.size()));
+    if (item.empty()) { continue; }
+    std::size_t equals{std::min(item.find('='), item.size())};
+    if (!decodeComponent(item.substr(0, equals), name) ||
+        !decodeComponent(item.substr(std::min(equals + 1, item.size())),
+                         value)) {
+      error = "Invalid query string";
+      return false;
+    }
+
+    if (name == (range ? "years" : "year")) {
+      Year year{};
+      calculation.years.clear();
+      if (range ? !parseYears(value, calculation.years)
+                : !parseYear(value, year)) {
+        error = "Invalid year: " + value;
+        return false;
+      }
+      if (!range) { calculation.years.push_back(YearRange{year, year}); }
+      given_years = true;
+    } else if (name == "method") {
+      if (value == "julian") {
+        calculation.method = e_calculation_method::julian;
+      } else if (value == "gregorian") {
+        calculation.method = e_calculation_method::gregorian;
+      } else {
+        error = "Invalid method: " + value;
+        return false;
+      }
+    } else if (name == "calendar") {
+      if (value == "julian") {
+        calendar = e_output_calendar::julian;
+      } else if (value == "gregorian") {
+        calendar = e_output_calendar::gregorian;
+      } else if (value == "revised_julian") {
+        calendar = e_output_calendar::rev_julian;
+      } else {
+        error = "Invalid calendar: " + value;
+        return false;
+      }
+    } else if (name == "targets") {
+      if (!parseTargets(value, calculation)) {
+        error = "Invalid targets: " + value;
+        return false;
+      }
+    } else if (name == "byzantine") {
+      if (value != "true" && value != "false") {
+        error = "Invalid byzantine: " + value;
+        return false;
+      }
+      calculation.byzantine = value == "true";
+    } else {
+      error = "Unknown parameter: " + name;
+      return false;
+    }
+  }
+
+  if (!given_years) {
+    if (range) {
+      error = "Missing parameter: years";
+      return false;
+    }
+    std::time_t now{std::time(nullptr)};
+    std::tm local{};
+    localtime_r(&now, &local);
+    Year year{local.tm_year + 1900};
+    calculation.years.push_back(YearRange{year, year});
+  }
+  // As with -g, the Gregorian method outputs Gregorian dates unless another
+  // calendar is given.
+  calculation.calendar = calendar.value_or(
+      calculation.method == e_calculation_method::gregorian
+          ? e_output_calendar::gregorian
+          : e_output_calendar::julian);
+  if (calculation.targets.empty()) { calculation.targets.push_back("pascha"); }
+
+  calculation.pascha = makeStaticPipeline(calculation.method,
+                                          e_target_output::pascha,
+                                          e_output_calendar::gregorian, false);
+  for (std::string_view target : calculation.targets) {
+    auto found{std::find_if(kTargets.begin(), kTargets.end(),
+                            [target](const auto& t) {
+                              return t.first == target;
+                            })};
+    calculation.finishes.push_back(staticPipelineFinish(
+        found->second, calculation.calendar, calculation.byzantine));
+  }
+  return true;
+} // parseParameters
+
+// Take up to a block of the years still to be sent, returning whether there
+// are more after them.
+bool nextYears(RangeStream& stream, std::vector<Year>& years)
+{
+  const std::vector<YearRange>& ranges{stream.calculation.years};
+  years.clear();
+  while (years.size() < kBlockSize) {
+    const YearRange& range{ranges[stream.range]};
+    Year year{stream.next};
+    years.push_back(year);
+    // The distance to the end of the range is computed unsigned so that
+    // ranges reaching the limits of Year do not overflow.
+    auto step{static_cast<std::uint64_t>(range.step)};
+    auto left{range.from <= range.to
+                  ? static_cast<std::uint64_t>(range.to) -
+                        static_cast<std::uint64_t>(year)
+                  : static_cast<std::uint64_t>(year) -
+                        static_cast<std::uint64_t>(range.to)};
+    if (left >= step) {
+      stream.next = range.from <= range.to ? year + range.step
+                                           : year - range.step;
+    } else if (++stream.range < ranges.size()) {
+      stream.next = ranges[stream.range].from;
+    } else {
+      return false;
+    }
+  }
+  return true;
+} // nextYears
+
+std::string_view reason(int status)
+{
+  switch (status) {
+    case 200: return "OK";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 431: return "Request Header Fields Too Large";
+    case 501: return "Not Implemented";
+    case 505: return "HTTP Version Not Supported";
+    default: return "Internal Server Error";
+  }
+} // reason
+
+// Append the status line and headers of a response. Without a content length,
+// the body is sent in chunks if the connection is kept alive, and is otherwise
+// ended by closing it, as HTTP/1.0 clients expect.
+void appendHead(Connection& connection, int status,
+                std::optional<std::size_t> content_length, bool keep_alive)
+{
+  std::string& out{connection.output};
+  out += "HTTP/1.1 ";
+  appendNumber(out, status);
+  out += ' ';
+  out += reason(status);
+  out += "\r\nContent-Type: application/json";
+  if (content_length) {
+    out += "\r\nContent-Length: ";
+    appendNumber(out, static_cast<std::int64_t>(*content_length));
+  } else if (keep_alive) {
+    out += "\r\nTransfer-Encoding: chunked";
+  }
+  if (status == 405) { out += "\r\nAllow: GET"; }
+  if (!keep_alive) {
+    out += "\r\nConnection: close";
+    connection.closing = true;
+  }
+  out += "\r\n\r\n";
+} // appendHead
+
+void respond(Connection& connection, int status, std::string_view body,
+             bool keep_alive)
+{
+  appendHead(connection, status, body.size(), keep_alive);
+  connection.output += body;
+} // respond
+
+void respondError(Connection& connection, int status, std::string_view message,
+                  bool keep_alive)
+{
+  std::string body{R"({"error":)"};
+  appendString(body, message);
+  body += '}';
+  respond(connection, status, body, keep_alive);
+} // respondError
+
+void appendChunk(std::string& out, std::string_view text)
+{
+  std::array<char, 16> digits{};
+  auto [end, ec] = std::to_chars(digits.begin(), digits.end(), text.size(), 16);
+  out.append(digits.data(), end);
+  out += "\r\n";
+  out += text;
+  out += "\r\n";
+} // appendChunk
+
+// Send the next block of years of the range being streamed, and the end of the
+// response after the last of them.
+void streamYears(Connection& connection, Scratch& scratch)
+{
+  RangeStream& stream{*connection.stream};
+  bool more{nextYears(stream, scratch.years)};
+  scratch.text.clear();
+  appendYears(scratch.text, stream.calculation, scratch.years, scratch,
+              stream.first);
+  if (!more) { scratch.text += "]}"; }
+  if (!stream.chunked) {
+    connection.output += scratch.text;
+  } else {
+    appendChunk(connection.output, scratch.text);
+    if (!more) { connection.output += "0\r\n\r\n"; }
+  }
+  if (!more) { connection.stream.reset(); }
+} // streamYears
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b)
+{
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+    return (x | 0x20) == (y | 0x20);
+  });
+} // equalsIgnoreCase
+
+std::string_view trim(std::string_view text)
+{
+  std::size_t start{std::min(text.find_first_not_of(" \t"), text.size())};
+  text.remove_prefix(start);
+  text.remove_suffix(text.size() -
+                     std::min(text.find_last_not_of(" \t") + 1, text.size()));
+  return text;
+} // trim
+
+// Parse the head of a request, without the empty line that ends it. Returns
+// the status of the response if it is invalid, or 0.
+int parseRequest(std::string_view head, Request& request)
+{
+  std::size_t end{std::min(head.find("\r\n"), head.size())};
+  std::string_view line{head.substr(0, end)};
+  head.remove_prefix(std::min(end + 2, head.size()));
+
+  std::size_t space{line.find(' ')};
+  std::size_t last{line.rfind(' ')};
+  if (space == std::string_view::npos || last == space) { return 400; }
+  request.method = line.substr(0, space);
+  request.target = line.substr(space + 1, last - space - 1);
+  std::string_view version{line.substr(last + 1)};
+  if (version == "HTTP/1.1") {
+    request.keep_alive = true;
+  } else if (version == "HTTP/1.0") {
+    request.keep_alive = false;
+  } else {
+    return version.starts_with("HTTP/") ? 505 : 400;
+  }
+
+  while (!head.empty()) {
+    end = std::min(head.find("\r\n"), head.size());
+    line = head.substr(0, end);
+    head.remove_prefix(std::min(end + 2, head.size()));
+    std::size_t colon{line.find(':')};
+    if (colon == std::string_view::npos) { return 400; }
+    std::string_view name{line.substr(0, colon)};
+    std::string_view value{trim(line.substr(colon + 1))};
+
+    if (equalsIgnoreCase(name, "Connection")) {
+      while (!value.empty()) {
+        std::string_view token{trim(value.substr(0, value.find(',')))};
+        value.remove_prefix(std::min(value.find(','), value.size() - 1) + 1);
+        if (equalsIgnoreCase(token, "close")) {
+          request.keep_alive = false;
+        } else if (equalsIgnoreCase(token, "keep-alive")) {
+          request.keep_alive = true;
+        }
+      }
+    } else if (equalsIgnoreCase(name, "Content-Length")) {
+      const char* last{value.data() + value.size()};
+      auto [ptr, ec] = std::from_chars(value.data(), last,
+                                       request.content_length);
+      if (ec != std::errc{} || ptr != last) {
+        return 400;
+      }
+    } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+      return 501;
+    }
+  }
+  return 0;
+} // parseRequest
+
+// Answer a request, or start streaming the answer to a request for a range.
+void answerRequest(Connection& connection, const Request& request,
+                   Scratch& scratch)
+{
+  std::string_view path{request.target.substr(0, request.target.find('?'))};
+  std::string_view query{request.target.substr(path.size())};
+  if (!query.empty()) { query.remove_prefix(1); }
+
+  bool range{path == "/pascha/range"};
+  if (!range && path != "/pascha") {
+    respondError(connection, 404, "Not found", request.keep_alive);
+    return;
+  }
+  if (request.method != "GET") {
+    respondError(connection, 405, "Method not allowed", request.keep_alive);
+    return;
+  }
+
+  Calculation calculation{};
+  std::string error{};
+  if (!parseParameters(query, range, calculation, error)) {
+    respondError(connection, 400, error, request.keep_alive);
+    return;
+  }
+
+  std::string& body{scratch.text};
+  body.clear();
+  body += '{';
+  appendOptions(body, calculation);
+  if (range) {
+    body += R"(,"years":[)";
+    appendHead(connection, 200, std::nullopt, request.keep_alive);
+    if (request.keep_alive) {
+      appendChunk(connection.output, body);
+    } else {
+      connection.output += body;
+    }
+    Year first{calculation.years.front().from};
+    connection.stream = RangeStream{std::move(calculation), 0, first, true,
+                                    request.keep_alive};
+    return;
+  }
+
+  Year year{calculation.years.front().from};
+  Checked<Date> pascha{calculation.pascha->tryCalculate(year)};
+  body += ',';
+  appendDates(body, calculation, year, pascha.value,
+              conversionErrorMessage(pascha.error));
+  body += '}';
+  respond(connection, 200, body, request.keep_alive);
+} // answerRequest
+
+std::size_t unwritten(const Connection& connection)
+{
+  return connection.output.size() - connection.written;
+} // unwritten
+
+// Answer the whole requests that have been read, in order, until the output
+// is full. A range being streamed is sent a block at a time, so that the other
+// connections of the worker are served between the blocks.
+void answerRequests(Connection& connection, Scratch& scratch)
+{
+  while (unwritten(connection) < kMaxBuffered) {
+    if (connection.stream) {
+      streamYears(connection, scratch);
+      if (connection.stream) { return; }
+      continue;
+    }
+    if (connection.closing) { return; }
+
+    std::string& input{connection.input};
+    if (connection.body > 0) {
+      std::size_t skip{std::min(connection.body, input.size())};
+      input.erase(0, skip);
+      connection.body -= skip;
+      if (connection.body > 0) { return; }
+    }
+    // Empty lines before a request are ignored.
+    std::size_t start{std::min(input.find_first_not_of("\r\n"), input.size())};
+    input.erase(0, start);
+
+    std::size_t end{input.find("\r\n\r\n")};
+    if (end == std::string::npos || end > kMaxHead) {
+      if (input.size() > kMaxHead) {
+        respondError(connection, 431, "Request header too large", false);
+      }
+      return;
+    }
+    Request request{};
+    int status{parseRequest(std::string_view{input}.substr(0, end), request)};
+    try {
+      if (status != 0) {
+        respondError(connection, status, reason(status), false);
+      } else {
+        connection.body = request.content_length;
+        answerRequest(connection, request, scratch);
+      }
+    } catch (const std::exception& e) {
+      respondError(connection, 500, e.what(), false);
+    }
+    input.erase(0, end + 4);
+  }
+} // answerRequests
+
+// Read what the client has sent, up to what can be buffered. Returns false if
+// the connection has failed.
+bool readRequests(int fd, Connection& connection)
+{
+  char buffer[1 << 16];
+  while (connection.input.size() < kMaxBuffered) {
+    ssize_t count{read(fd, buffer, sizeof(buffer))};
+    if (count > 0) {
+      connection.input.append(buffer, static_cast<std::size_t>(count));
+    } else if (count == 0) {
+      connection.finished = true;
+      break;
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      break;
+    } else if (errno != EINTR) {
+      return false;
+    }
+  }
+  return true;
+} // readRequests
+
+// Write as much of the responses as the socket takes without blocking.
+// Returns false if the connection has failed.
+bool writeResponses(int fd, Connection& connection)
+{
+  while (unwritten(connection) > 0) {
+    ssize_t count{send(fd, connection.output.data() + connection.written,
+                       unwritten(connection), MSG_NOSIGNAL)};
+    if (count >= 0) {
+      connection.written += static_cast<std::size_t>(count);
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      return true;
+    } else if (errno != EINTR) {
+      return false;
+    }
+  }
+  connection.output.clear();
+  connection.written = 0;
+  return true;
+} // writeResponses
+
+// Serve a client on an event from its socket. Returns false when the
+// connection is to be closed.
+bool serveClient(int fd, Connection& connection, std::uint32_t events,
+                 Scratch& scratch, int epoll)
+{
+  if ((events & (EPOLLIN | EPOLLHUP | EPOLLERR)) &&
+      !readRequests(fd, connection)) {
+    return false;
+  }
+  answerRequests(connection, scratch);
+  if (!writeResponses(fd, connection)) { return false; }
+  // Answer any requests held back while the output was full.
+  if (connection.output.empty() && !connection.stream) {
+    answerRequests(connection, scratch);
+    if (!writeResponses(fd, connection)) { return false; }
+  }
+  bool idle{connection.output.empty() && !connection.stream};
+  if (idle && (connection.closing || connection.finished)) { return false; }
+
+  std::uint32_t interest{0};
+  if (!connection.closing && !connection.finished && !connection.stream &&
+      unwritten(connection) < kMaxBuffered &&
+      connection.input.size() < kMaxBuffered) {
+    interest |= EPOLLIN;
+  }
+  if (!idle) { interest |= EPOLLOUT; }
+  if (interest != connection.interest) {
+    epoll_event event{};
+    event.events = interest;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &event) != 0) { return false; }
+    connection.interest = interest;
+  }
+  return true;
+} // serveClient
+
+void acceptClients(const Worker& worker,
+                   std::unordered_map<int, Connection>& connections)
+{
+  int fd{};
+  while ((fd = accept4(worker.listener, nullptr, nullptr,
+                       SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+    // Responses are written whole, so there is nothing to gain by delaying
+    // small ones.
+    int one{1};
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(worker.events, EPOLL_CTL_ADD, fd, &event) != 0) {
+      close(fd);
+      continue;
+    }
+    connections.emplace(fd, Connection{});
+  }
+} // acceptClients
+
+void runWorker(Worker& worker)
+{
+  std::unordered_map<int, Connection> connections{};
+  Scratch scratch{};
+  std::array<epoll_event, 64> ready{};
+  bool stop{false};
+  while (!stop) {
+    int count{epoll_wait(worker.events, ready.data(),
+                         static_cast<int>(ready.size()), -1)};
+    if (count < 0) {
+      if (errno == EINTR) { continue; }
+      worker.error = systemError("Could not wait for events");
+      break;
+    }
+    for (const epoll_event& event :
+         std::span{ready}.first(static_cast<std::size_t>(count))) {
+      int fd{event.data.fd};
+      if (fd == g_stop_fd) {
+        stop = true;
+      } else if (fd == worker.listener) {
+        acceptClients(worker, connections);
+      } else if (auto found{connections.find(fd)};
+                 found != connections.end() &&
+                 !serveClient(fd, found->second, event.events, scratch,
+                              worker.events)) {
+        close(fd);
+        connections.erase(found);
+      }
+    }
+  }
+  for (const auto& [fd, connection] : connections) { close(fd); }
+} // runWorker
+
+// Resolve an address given as [HOST:]PORT, where a HOST which is an IPv6
+// address is in brackets. Without a HOST, only local clients can connect.
+addrinfo* resolve(const std::string& address, std::string& error)
+{
+  std::size_t colon{address.rfind(':')};
+  std::string host{colon == std::string::npos ? "127.0.0.1"
+                                              : address.substr(0, colon)};
+  std::string port{address.substr(colon + 1)};
+  if (host.size() >= 2 && host.front() == '[' && host.back() == ']') {
+    host = host.substr(1, host.size() - 2);
+  }
+  int number{};
+  auto [end, ec] = std::from_chars(port.data(), port.data() + port.size(),
+                                   number);
+  if (ec != std::errc{} || end != port.data() + port.size() || number < 1 ||
+      number > 65535) {
+    error = "Invalid port: " + port;
+    return nullptr;
+  }
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+  addrinfo* found{nullptr};
+  if (int status{getaddrinfo(host.c_str(), port.c_str(), &hints, &found)};
+      status != 0) {
+    error = "Invalid address: " + address + ": " + gai_strerror(status);
+    return nullptr;
+  }
+  return found;
+} // resolve
+
+// Set up the listening socket and event loop of a worker. Every worker listens
+// on the same address, and the kernel shares the connections between them.
+bool listenOn(const addrinfo& address, const std::string& name, Worker& worker,
+              std::string& error)
+{
+  worker.listener = socket(address.ai_family,
+                           address.ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                           address.ai_protocol);
+  int one{1};
+  if (worker.listener < 0 ||
+      setsockopt(worker.listener, SOL_SOCKET, SO_REUSEADDR, &one,
+                 sizeof(one)) != 0 ||
+      setsockopt(worker.listener, SOL_SOCKET, SO_REUSEPORT, &one,
+                 sizeof(one)) != 0 ||
+      bind(worker.listener, address.ai_addr, address.ai_addrlen) != 0 ||
+      listen(worker.listener, SOMAXCONN) != 0) {
+    error = systemError("Could not listen on " + name);
+    return false;
+  }
+
+  worker.events = epoll_create1(EPOLL_CLOEXEC);
+  epoll_event listener{};
+  listener.events = EPOLLIN;
+  listener.data.fd = worker.listener;
+  epoll_event stop{};
+  stop.events = EPOLLIN;
+  stop.data.fd = g_stop_fd;
+  if (worker.events < 0 ||
+      epoll_ctl(worker.events, EPOLL_CTL_ADD, worker.listener, &listener) !=
+          0 ||
+      epoll_ctl(worker.events, EPOLL_CTL_ADD, g_stop_fd, &stop) != 0) {
+    error = systemError("Could not create event loop");
+    return false;
+  }
+  return true;
+} // listenOn
+
+#endif
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+#if defined(__linux__)
+
+bool serveHttp(const std::string& address, std::size_t threads,
+               std::string& error)
+{
+  addrinfo* found{resolve(address, error)};
+  if (!found) { return false; }
+
+  std::vector<Worker> workers(std::max<std::size_t>(threads, 1));
+  g_stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  bool ready{g_stop_fd >= 0};
+  if (!ready) { error = systemError("Could not create event"); }
+  for (Worker& worker : workers) {
+    if (!ready) { break; }
+    ready = listenOn(*found, address, worker, error);
+  }
+  freeaddrinfo(found);
+
+  if (ready) {
+    // Stop on SIGINT or SIGTERM, waking every worker.
+    struct sigaction stop{};
+    stop.sa_handler = stopWorkers;
+    sigemptyset(&stop.sa_mask);
+    struct sigaction old_int{};
+    struct sigaction old_term{};
+    sigaction(SIGINT, &stop, &old_int);
+    sigaction(SIGTERM, &stop, &old_term);
+
+    std::vector<std::thread> running{};
+    for (Worker& worker : workers) {
+      running.emplace_back([&worker] { runWorker(worker); });
+    }
+    for (std::thread& thread : running) { thread.join(); }
+
+    sigaction(SIGINT, &old_int, nullptr);
+    sigaction(SIGTERM, &old_term, nullptr);
+    for (const Worker& worker : workers) {
+      if (error.empty()) { error = worker.error; }
+    }
+  }
+
+  for (const Worker& worker : workers) {
+    if (worker.events >= 0) { close(worker.events); }
+    if (worker.listener >= 0) { close(worker.listener); }
+  }
+  if (g_stop_fd >= 0) { close(g_stop_fd); }
+  g_stop_fd = -1;
+  return error.empty();
+} // serveHttp
+
+#else // epoll and SO_REUSEPORT as used here are Linux only
+
+bool serveHttp(const std::string&, std::size_t, std::string& error)
+{
+  error = "--http is not supported on this system";
+  return false;
+} // serveHttp
+
+#endif
+
+} // namespace pascha
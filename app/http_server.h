@@ -0,0 +1,52 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_HTTP_SERVER_H
+#define PASCHA_HTTP_SERVER_H
+
+#include <cstddef>
+#include <string>
+
+// An HTTP/1.1 server for pascha, which answers requests for dates with JSON so
+// that services which can not link pascha-lib can use it. There are two
+// resources, both of which take the parameters method (julian or gregorian),
+// calendar (julian, gregorian or revised_julian), targets (a comma separated
+// list of pascha, meatfare, cheesefare, ash_wednesday, midfeast_of_pentecost,
+// leavetaking_of_pascha, ascension and pentecost) and byzantine (true or
+// false):
+//
+//   GET /pascha?year=YEAR answers the dates for a single year, the current
+//   year if none is given.
+//   GET /pascha/range?years=YEARS answers the dates for each of YEARS, given
+//   as for -y, streamed in chunks as they are calculated.
+
+namespace pascha
+{
+
+// Answer HTTP requests on address, given as [HOST:]PORT, until interrupted by
+// SIGINT or SIGTERM. Each of threads workers has a socket of its own on the
+// address and an event loop for its connections. Returns false with a message
+// in error if the sockets can not be set up.
+bool serveHttp(const std::string& address, std::size_t threads,
+               std::string& error);
+
+} // namespace pascha
+
+#endif // !PASCHA_HTTP_SERVER_H
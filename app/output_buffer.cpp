@@ -0,0 +1,76 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "output_buffer.h"
+
+namespace pascha
+{
+OutputBuffer::OutputBuffer(std::ostream& stream)
+    : m_stream{stream}, m_sink{stream.rdbuf()}
+{
+  setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+  m_stream.rdbuf(this);
+} // OutputBuffer::OutputBuffer(std::ostream&)
+
+OutputBuffer::~OutputBuffer()
+{
+  sync();
+  m_stream.rdbuf(m_sink);
+} // OutputBuffer::~OutputBuffer()
+
+OutputBuffer::int_type OutputBuffer::overflow(int_type ch)
+{
+  if (!writeOut()) { return traits_type::eof(); }
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+} // OutputBuffer::overflow(int_type)
+
+int OutputBuffer::sync()
+{
+  if (!writeOut()) { return -1; }
+  return m_sink->pubsync();
+} // OutputBuffer::sync()
+
+bool OutputBuffer::writeOut()
+{
+  std::streamsize size{pptr() - pbase()};
+  bool written{m_sink->sputn(pbase(), size) == size};
+  setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+  return written;
+} // OutputBuffer::writeOut()
+
+StringBuffer::int_type StringBuffer::overflow(int_type ch)
+{
+  if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+    m_text += traits_type::to_char_type(ch);
+  }
+  return traits_type::not_eof(ch);
+} // StringBuffer::overflow(int_type)
+
+std::streamsize StringBuffer::xsputn(const char* text, std::streamsize count)
+{
+  m_text.append(text, static_cast<std::size_t>(count));
+  return count;
+} // StringBuffer::xsputn(const char*, std::streamsize)
+
+} // namespace pascha
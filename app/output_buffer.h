@@ -0,0 +1,82 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_OUTPUT_BUFFER_H
+#define PASCHA_OUTPUT_BUFFER_H
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace pascha
+{
+
+// A large buffer installed in front of the buffer of a stream for as long as
+// it exists, so that output is passed on in big blocks rather than line by
+// line. It is written out when full, when the stream is flushed (including by
+// a tied stream, such as std::cerr for std::cout) and when it is destroyed.
+class OutputBuffer : public std::streambuf
+{
+ public:
+  static constexpr std::size_t kSize{1 << 16};
+
+  explicit OutputBuffer(std::ostream& stream);
+  OutputBuffer(const OutputBuffer&) = delete;
+  OutputBuffer(OutputBuffer&&) = delete;
+  OutputBuffer& operator=(const OutputBuffer&) = delete;
+  OutputBuffer& operator=(OutputBuffer&&) = delete;
+  ~OutputBuffer();
+
+ protected:
+  int_type overflow(int_type ch) override;
+  int sync() override;
+
+ private:
+  std::ostream& m_stream;
+  std::streambuf* m_sink;
+  std::array<char, kSize> m_buffer{};
+
+  bool writeOut();
+}; // class OutputBuffer
+
+// A buffer that appends what is written to a string, so that a stream can
+// write the output of a query straight into the response to it.
+class StringBuffer : public std::streambuf
+{
+ public:
+  explicit StringBuffer(std::string& text) : m_text{text} {}
+  StringBuffer(const StringBuffer&) = delete;
+  StringBuffer(StringBuffer&&) = delete;
+  StringBuffer& operator=(const StringBuffer&) = delete;
+  StringBuffer& operator=(StringBuffer&&) = delete;
+  ~StringBuffer() = default;
+
+ protected:
+  int_type overflow(int_type ch) override;
+  std::streamsize xsputn(const char* text, std::streamsize count) override;
+
+ private:
+  std::string& m_text;
+}; // class StringBuffer
+
+} // namespace pascha
+#endif // !PASCHA_OUTPUT_BUFFER_H
@@ -0,0 +1,373 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "query.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <thread>
+#include <utility>
+
+namespace
+{
+using namespace pascha;
+
+// The options which select target dates and the printing of the year. The
+// target dates are output in a fixed order, whatever order they are given in.
+struct Flags
+{
+  bool suppress_year{false};
+  bool suppress_pascha{false};
+  bool chronological{false};
+  bool given_year{false};
+  bool bare_year{false};
+  bool days_until{false};
+  bool weeks_between{false};
+  bool meatfare{false};
+  bool cheesefare{false};
+  bool ash_wednesday{false};
+  bool midfeast{false};
+  bool leavetaking{false};
+  bool ascension{false};
+  bool pentecost{false};
+}; // struct Flags
+
+// Apply a short option which takes no argument.
+bool applyFlag(char option, Query& query, Flags& flags)
+{
+  CalculationOptions& options{query.options};
+  switch (option) {
+    case 'j':
+      options.calculation_method = e_calculation_method::julian;
+      break;
+    case 'g':
+      options.calculation_method = e_calculation_method::gregorian;
+      options.output_calendar = e_output_calendar::gregorian;
+      break;
+    case 'J': options.output_calendar = e_output_calendar::julian; break;
+    case 'R': options.output_calendar = e_output_calendar::rev_julian; break;
+    case 'G': options.output_calendar = e_output_calendar::gregorian; break;
+    case 'b': options.options.push_back(e_output_option::byzantine); break;
+    case 's': flags.suppress_year = true; break;
+    case 'd': flags.days_until = true; break;
+    case 'D': flags.weeks_between = true; break;
+    case 'm': flags.meatfare = true; break;
+    case 'c': flags.cheesefare = true; break;
+    case 'a': flags.ash_wednesday = true; break;
+    case 'M': flags.midfeast = true; break;
+    case 'l': flags.leavetaking = true; break;
+    case 'A': flags.ascension = true; break;
+    case 'p': flags.pentecost = true; break;
+    case 'x': flags.suppress_pascha = true; break;
+    case 'X':
+      flags.chronological = true;
+      flags.suppress_pascha = true;
+      break;
+    case 'v': options.options.push_back(e_output_option::verbose); break;
+    case 'V':
+      options.options.push_back(e_output_option::verbose);
+      options.options.push_back(e_output_option::easter);
+      break;
+    case 'h': query.help = true; break;
+    default: return false;
+  }
+  return true;
+} // applyFlag
+
+// Apply an option which takes an argument, by its short or long name.
+bool applyOption(std::string_view name, std::string_view value, Query& query,
+                 Flags& flags, std::string& error)
+{
+  CalculationOptions& options{query.options};
+  if (name == "y") {
+    options.years.clear();
+    if (!parseYears(value, options.years)) {
+      error = "Invalid year: ";
+      error += value;
+      return false;
+    }
+    flags.given_year = true;
+  } else if (name == "S") {
+    query.date_separator = value;
+  } else if (name == "jobs") {
+    Year jobs{};
+    if (!parseYear(value, jobs) || jobs < 0) {
+      error = "Invalid number of jobs: ";
+      error += value;
+      return false;
+    }
+    // Zero uses a thread for each core.
+    options.threads = jobs == 0 ? std::thread::hardware_concurrency()
+                                : static_cast<std::size_t>(jobs);
+  } else if (name == "format") {
+    if (value == "arrow") {
+      options.options.push_back(e_output_option::arrow);
+    } else if (value != "text") {
+      error = "Invalid format: ";
+      error += value;
+      return false;
+    }
+  } else if (name == "serve" || name == "connect") {
+    if (value.empty()) {
+      error = "Invalid socket path";
+      return false;
+    }
+    (name == "serve" ? query.serve : query.connect) = value;
+  } else if (name == "http") {
+    if (value.empty()) {
+      error = "Invalid address";
+      return false;
+    }
+    query.http = value;
+  } else if (name == "on") {
+    if (!parseMonthDay(value, options.search_month, options.search_day)) {
+      error = "Invalid date: ";
+      error += value;
+      return false;
+    }
+  } else if (name == "weeks") {
+    Year weeks{};
+    if (!parseYear(value, weeks)) {
+      error = "Invalid number of weeks: ";
+      error += value;
+      return false;
+    }
+    options.search_weeks = weeks;
+  }
+  return true;
+} // applyOption
+
+bool takesArgument(char option) { return option == 'y' || option == 'S'; }
+
+bool isLongOption(std::string_view name)
+{
+  return name == "jobs" || name == "format" || name == "serve" ||
+         name == "connect" || name == "http" || name == "on" ||
+         name == "weeks";
+} // isLongOption
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+bool parseYear(std::string_view text, Year& year)
+{
+  const char* end{text.data() + text.size()};
+  auto [ptr, ec] = std::from_chars(text.data(), end, year);
+  return ec == std::errc{} && ptr == end;
+} // parseYear
+
+bool parseMonthDay(std::string_view text, Month& month, Day& day)
+{
+  constexpr std::array<Day, 12> kMonthDays{31, 29, 31, 30, 31, 30,
+                                           31, 31, 30, 31, 30, 31};
+  const char* end{text.data() + text.size()};
+  auto [sep, month_ec] = std::from_chars(text.data(), end, month);
+  if (month_ec != std::errc{} || sep == end || (*sep != '-' && *sep != '/')) {
+    return false;
+  }
+  auto [ptr, day_ec] = std::from_chars(sep + 1, end, day);
+  return day_ec == std::errc{} && ptr == end && month >= 1 && month <= 12 &&
+         day >= 1 && day <= kMonthDays[month - 1];
+} // parseMonthDay
+
+bool parseYears(std::string_view text, std::vector<YearRange>& years)
+{
+  using namespace std::literals; // for sv
+
+  while (true) {
+    std::string_view item{text.substr(0, text.find(','))};
+    YearRange range{};
+
+    std::size_t dots{item.find(".."sv)};
+    if (dots == std::string_view::npos) {
+      if (!parseYear(item, range.from)) { return false; }
+      range.to = range.from;
+    } else {
+      std::string_view to{item.substr(dots + 2)};
+      std::size_t colon{to.find(':')};
+      if (colon != std::string_view::npos) {
+        if (!parseYear(to.substr(colon + 1), range.step) || range.step < 1) {
+          return false;
+        }
+        to = to.substr(0, colon);
+      }
+      if (!parseYear(item.substr(0, dots), range.from) ||
+          !parseYear(to, range.to)) {
+        return false;
+      }
+    }
+    years.push_back(range);
+
+    if (item.size() == text.size()) { return true; }
+    text.remove_prefix(item.size() + 1);
+  }
+} // parseYears
+
+bool parseQuery(std::span<const std::string_view> args, Query& query,
+                std::string& error, bool bare_years)
+{
+  Query parsed{};
+  Flags flags{};
+
+  for (std::size_t i{0}; i < args.size(); ++i) {
+    std::string_view arg{args[i]};
+    if (arg == "--") { break; }
+
+    // Long options, with the argument after = or in the next argument
+    if (arg.starts_with("--")) {
+      std::string_view name{arg.substr(2)};
+      std::string_view value{};
+      std::size_t equals{name.find('=')};
+      if (name == "help") {
+        parsed.help = true;
+        continue;
+      }
+      if (name == "stdin") {
+        parsed.read_stdin = true;
+        continue;
+      }
+      if (name == "stats") {
+        parsed.options.statistics = true;
+        continue;
+      }
+      if (!isLongOption(name.substr(0, equals))) {
+        error = "Unknown option: ";
+        error += arg;
+        return false;
+      }
+      if (equals != std::string_view::npos) {
+        value = name.substr(equals + 1);
+        name = name.substr(0, equals);
+      } else if (i + 1 < args.size()) {
+        value = args[++i];
+      } else {
+        error = "Missing argument for ";
+        error += arg;
+        return false;
+      }
+      if (!applyOption(name, value, parsed, flags, error)) { return false; }
+      continue;
+    }
+
+    // Arguments which are not options are ignored, as getopt leaves them,
+    // unless they are taken as years. A negative year can not be mistaken for
+    // options, as no option is a digit.
+    bool option{arg.size() >= 2 && arg.front() == '-'};
+    if (bare_years && (!option || (arg[1] >= '0' && arg[1] <= '9'))) {
+      if (!flags.bare_year) { parsed.options.years.clear(); }
+      if (!parseYears(arg, parsed.options.years)) {
+        error = "Invalid year: ";
+        error += arg;
+        return false;
+      }
+      flags.given_year = true;
+      flags.bare_year = true;
+      continue;
+    }
+    if (!option) { continue; }
+
+    // Grouped short options, the last of which may take an argument
+    for (std::size_t j{1}; j < arg.size(); ++j) {
+      char option{arg[j]};
+      if (takesArgument(option)) {
+        std::string_view value{arg.substr(j + 1)};
+        if (value.empty()) {
+          if (i + 1 >= args.size()) {
+            error = "Missing argument for -";
+            error += option;
+            return false;
+          }
+          value = args[++i];
+        }
+        if (!applyOption(std::string_view{&option, 1}, value, parsed, flags,
+                         error)) {
+          return false;
+        }
+        break;
+      }
+      if (!applyFlag(option, parsed, flags)) {
+        error = "Unknown option: -";
+        error += option;
+        return false;
+      }
+    }
+  }
+
+  std::vector<ETargetOutput>& targets{parsed.options.target_outputs};
+  if (!flags.suppress_pascha) { targets.push_back(e_target_output::pascha); }
+  if (flags.days_until) { targets.push_back(e_target_output::daysUntil); }
+  if (flags.weeks_between) {
+    targets.push_back(e_target_output::weeksBetween);
+  }
+  if (flags.meatfare) { targets.push_back(e_target_output::meatfare); }
+  if (flags.cheesefare) { targets.push_back(e_target_output::cheesefare); }
+  if (flags.ash_wednesday) {
+    targets.push_back(e_target_output::ashWednesday);
+  }
+  if (flags.chronological) { targets.push_back(e_target_output::pascha); }
+  if (flags.midfeast) {
+    targets.push_back(e_target_output::midfeastPentecost);
+  }
+  if (flags.leavetaking) {
+    targets.push_back(e_target_output::leavetakingPascha);
+  }
+  if (flags.ascension) { targets.push_back(e_target_output::ascension); }
+  if (flags.pentecost) { targets.push_back(e_target_output::pentecost); }
+
+  // The smallest year indicates that no year was given.
+  parsed.options.year = flags.given_year ? parsed.options.years.front().from
+                                         : -9223372036854775807;
+  // The years found by a search, and the years of statistics, are always
+  // printed, as they are the answer.
+  bool search{parsed.options.search_month != 0 ||
+              parsed.options.search_weeks.has_value()};
+  if (parsed.options.search_month != 0 && parsed.options.search_weeks) {
+    error = "--on can not be used with --weeks";
+    return false;
+  }
+  if (search && parsed.options.statistics) {
+    error = "--stats can not be used with --on or --weeks";
+    return false;
+  }
+  parsed.print_year = !flags.suppress_year &&
+                      (flags.given_year || search || parsed.options.statistics);
+
+  query = std::move(parsed);
+  return true;
+} // parseQuery
+
+std::vector<std::string_view> splitQuery(std::string_view line)
+{
+  constexpr std::string_view kSpace{" \t\r\n\v\f"};
+  std::vector<std::string_view> args{};
+  while (true) {
+    std::size_t start{line.find_first_not_of(kSpace)};
+    if (start == std::string_view::npos) { return args; }
+    line.remove_prefix(start);
+    std::size_t end{std::min(line.find_first_of(kSpace), line.size())};
+    args.push_back(line.substr(0, end));
+    line.remove_prefix(end);
+  }
+} // splitQuery
+
+} // namespace pascha
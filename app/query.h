@@ -0,0 +1,92 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_QUERY_H
+#define PASCHA_QUERY_H
+
+#include "pascha/calculation_options.h"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pascha
+{
+
+namespace e_output_option
+{
+
+enum
+{
+  verbose = pascha::e_output_option::last,
+  easter,
+  arrow,
+}; // enum
+
+} // namespace e_output_option
+
+// A calculation as given by the command line options of pascha, with how its
+// results are printed and the options that apply to the whole process.
+struct Query
+{
+  CalculationOptions options{};
+  // The separator of the month, day and year, if one is given.
+  std::optional<std::string> date_separator{};
+  // Whether the year is printed after each date.
+  bool print_year{false};
+  bool help{false};
+  // The Unix domain socket to answer queries on, or to send them to.
+  std::string serve{};
+  std::string connect{};
+  // The address to answer HTTP requests on, as [HOST:]PORT.
+  std::string http{};
+  // Whether queries are read from stdin, one per line.
+  bool read_stdin{false};
+}; // struct Query
+
+// Parse the command line options of pascha, not including the program name,
+// into query. The options are the same as for getopt_long: short options may
+// be grouped, their arguments may be attached or in the next argument, long
+// option arguments may follow =, arguments that are not options are ignored,
+// and -- ends the options. Unlike getopt this keeps no global state, so it can
+// be used for any number of queries. With bare_years, arguments which are not
+// options are instead years as for -y, replacing any given before them.
+// Returns false with a message in error if the options are invalid.
+bool parseQuery(std::span<const std::string_view> args, Query& query,
+                std::string& error, bool bare_years = false);
+
+// Parse a full 64-bit year, rejecting any trailing characters.
+bool parseYear(std::string_view text, Year& year);
+
+// Parse a comma separated list of years and year ranges, where each item is
+// either YEAR, FROM..TO, or FROM..TO:STEP, appending them to years.
+bool parseYears(std::string_view text, std::vector<YearRange>& years);
+
+// Parse a month and day as MM-DD or MM/DD, allowing 29 February.
+bool parseMonthDay(std::string_view text, Month& month, Day& day);
+
+// Split a line of options into arguments at whitespace.
+std::vector<std::string_view> splitQuery(std::string_view line);
+
+} // namespace pascha
+
+#endif // !PASCHA_QUERY_H
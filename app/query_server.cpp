@@ -0,0 +1,409 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "query_server.h"
+#include "output_buffer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+using namespace pascha;
+
+#if !defined(_WIN32)
+
+// The longest request line accepted, so that a client can not make the server
+// buffer without limit.
+constexpr std::size_t kMaxRequest{1 << 16};
+// The most input or output held for a client. Past it, no more is read from
+// the client or answered until it has read some of the responses.
+constexpr std::size_t kMaxBuffered{1 << 16};
+
+// Set by the signal handler to stop the server.
+volatile std::sig_atomic_t g_stop{0};
+
+extern "C" void stopServing(int) { g_stop = 1; }
+
+// The message for the error of the last system call.
+std::string systemError(std::string_view what)
+{
+  std::string error{what};
+  error += ": ";
+  error += std::strerror(errno);
+  return error;
+} // systemError
+
+// Fill in the address of the socket at path.
+bool socketAddress(const std::string& path, sockaddr_un& address,
+                   std::string& error)
+{
+  address = sockaddr_un{};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    error = "Socket path too long: " + path;
+    return false;
+  }
+  path.copy(address.sun_path, path.size());
+  return true;
+} // socketAddress
+
+bool setNonBlocking(int fd)
+{
+  int flags{fcntl(fd, F_GETFL)};
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0 &&
+         fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+} // setNonBlocking
+
+// A connected client, with what has been read from it that is not yet
+// answered, the response being calculated, and the responses not yet written
+// to it.
+struct Client
+{
+  int fd;
+  std::string input{};
+  QueryResponse response{};
+  std::string output{};
+  std::size_t written{0};
+  // Whether the client has finished sending requests.
+  bool closing{false};
+}; // struct Client
+
+std::size_t unwritten(const Client& client)
+{
+  return client.output.size() - client.written;
+} // unwritten
+
+// Whether the client has nothing more to be answered or written.
+bool idle(const Client& client)
+{
+  return client.output.empty() && !client.response;
+} // idle
+
+// Answer the whole lines of input, and the rest of it if the client has
+// finished sending, in order, until the output is full. A response is
+// calculated a block at a time, so that the other clients are served between
+// the blocks.
+void answerRequests(Client& client, const QueryAnswer& answer)
+{
+  while (unwritten(client) < kMaxBuffered) {
+    if (client.response) {
+      // The other clients are served before the next block.
+      if (client.response(client.output)) { return; }
+      client.response = nullptr;
+      client.output += '\n';
+      continue;
+    }
+
+    std::size_t end{client.input.find('\n')};
+    if (end == std::string::npos) {
+      if (!client.closing || client.input.empty()) { return; }
+      end = client.input.size();
+    }
+    client.response = answer(std::string_view{client.input}.substr(0, end));
+    client.input.erase(0, std::min(end + 1, client.input.size()));
+  }
+} // answerRequests
+
+// Read what the client has sent, up to what can be buffered. Returns false if
+// the connection has failed or a request is too long.
+bool readRequests(Client& client)
+{
+  char buffer[1 << 16];
+  while (client.input.size() < kMaxBuffered) {
+    ssize_t count{read(client.fd, buffer, sizeof(buffer))};
+    if (count > 0) {
+      client.input.append(buffer, static_cast<std::size_t>(count));
+    } else if (count == 0) {
+      client.closing = true;
+      break;
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      break;
+    } else if (errno != EINTR) {
+      return false;
+    }
+  }
+  return client.input.size() <= kMaxRequest ||
+         client.input.find('\n') != std::string::npos;
+} // readRequests
+
+// Write as much of the responses as the socket takes without blocking.
+// Returns false if the connection has failed.
+bool writeResponses(Client& client)
+{
+  while (unwritten(client) > 0) {
+    ssize_t count{write(client.fd, client.output.data() + client.written,
+                        unwritten(client))};
+    if (count >= 0) {
+      client.written += static_cast<std::size_t>(count);
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      // Drop what is written, so that the output of a long response does not
+      // grow while the client keeps some of it unread.
+      client.output.erase(0, client.written);
+      client.written = 0;
+      return true;
+    } else if (errno != EINTR) {
+      return false;
+    }
+  }
+  client.output.clear();
+  client.written = 0;
+  return true;
+} // writeResponses
+
+// Write all of text to the socket, blocking as needed.
+bool writeAll(int fd, std::string_view text)
+{
+  while (!text.empty()) {
+    ssize_t count{write(fd, text.data(), text.size())};
+    if (count < 0) {
+      if (errno == EINTR) { continue; }
+      return false;
+    }
+    text.remove_prefix(static_cast<std::size_t>(count));
+  }
+  return true;
+} // writeAll
+
+// Copy a line of a response to the output, dropping the empty line that ends
+// each response and sending errors to std::cerr.
+void printResponseLine(std::string_view line)
+{
+  if (line.empty()) { return; }
+  std::ostream& out{line.starts_with("Error: ") ? std::cerr : std::cout};
+  out.write(line.data(), static_cast<std::streamsize>(line.size()));
+  out.put('\n');
+} // printResponseLine
+
+#endif
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+#if !defined(_WIN32)
+
+bool serveQueries(const std::string& path, const QueryAnswer& answer,
+                  std::string& error)
+{
+  sockaddr_un address{};
+  if (!socketAddress(path, address, error)) { return false; }
+
+  int listener{socket(AF_UNIX, SOCK_STREAM, 0)};
+  if (listener < 0) {
+    error = systemError("Could not create socket");
+    return false;
+  }
+
+  // Replace a socket left by an earlier server, but nothing else.
+  struct stat status{};
+  if (lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+    unlink(path.c_str());
+  }
+  if (bind(listener, reinterpret_cast<const sockaddr*>(&address),
+           sizeof(address)) != 0 ||
+      listen(listener, SOMAXCONN) != 0 || !setNonBlocking(listener)) {
+    error = systemError("Could not listen on " + path);
+    close(listener);
+    return false;
+  }
+
+  // Stop on SIGINT or SIGTERM, interrupting poll, and report a client that
+  // has gone as an error from write rather than by SIGPIPE.
+  struct sigaction stop{};
+  stop.sa_handler = stopServing;
+  sigemptyset(&stop.sa_mask);
+  struct sigaction ignore{};
+  ignore.sa_handler = SIG_IGN;
+  sigemptyset(&ignore.sa_mask);
+  struct sigaction old_int{};
+  struct sigaction old_term{};
+  struct sigaction old_pipe{};
+  sigaction(SIGINT, &stop, &old_int);
+  sigaction(SIGTERM, &stop, &old_term);
+  sigaction(SIGPIPE, &ignore, &old_pipe);
+  g_stop = 0;
+
+  std::vector<Client> clients{};
+  std::vector<pollfd> fds{};
+  while (!g_stop) {
+    fds.clear();
+    fds.push_back(pollfd{listener, POLLIN, 0});
+    for (const Client& client : clients) {
+      // Nothing more is read while a response is being calculated or the
+      // buffers are full, and a response being calculated is continued as
+      // the client reads it.
+      short events{0};
+      if (!client.closing && !client.response &&
+          unwritten(client) < kMaxBuffered &&
+          client.input.size() < kMaxBuffered) {
+        events |= POLLIN;
+      }
+      if (!idle(client)) { events |= POLLOUT; }
+      fds.push_back(pollfd{client.fd, events, 0});
+    }
+
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) { continue; }
+      error = systemError("Could not poll");
+      break;
+    }
+
+    for (std::size_t i{0}; i < clients.size(); ++i) {
+      Client& client{clients[i]};
+      short events{fds[i + 1].revents};
+      bool connected{true};
+      if (events & (POLLIN | POLLHUP | POLLERR)) {
+        connected = readRequests(client);
+      }
+      if (connected) {
+        answerRequests(client, answer);
+        connected = writeResponses(client);
+      }
+      // Answer any requests held back while the output was full.
+      if (connected && idle(client)) {
+        answerRequests(client, answer);
+        connected = writeResponses(client);
+      }
+      if (!connected ||
+          (client.closing && client.input.empty() && idle(client))) {
+        close(client.fd);
+        client.fd = -1;
+      }
+    }
+    std::erase_if(clients, [](const Client& client) { return client.fd < 0; });
+
+    if (fds.front().revents & POLLIN) {
+      int fd{};
+      while ((fd = accept(listener, nullptr, nullptr)) >= 0) {
+        if (setNonBlocking(fd)) {
+          clients.push_back(Client{fd});
+        } else {
+          close(fd);
+        }
+      }
+    }
+  }
+
+  for (const Client& client : clients) { close(client.fd); }
+  close(listener);
+  unlink(path.c_str());
+  sigaction(SIGINT, &old_int, nullptr);
+  sigaction(SIGTERM, &old_term, nullptr);
+  sigaction(SIGPIPE, &old_pipe, nullptr);
+  return error.empty();
+} // serveQueries
+
+bool sendQueries(const std::string& path,
+                 std::span<const std::string_view> args, std::string& error)
+{
+  sockaddr_un address{};
+  if (!socketAddress(path, address, error)) { return false; }
+
+  int server{socket(AF_UNIX, SOCK_STREAM, 0)};
+  if (server < 0 ||
+      connect(server, reinterpret_cast<const sockaddr*>(&address),
+              sizeof(address)) != 0) {
+    error = systemError("Could not connect to " + path);
+    if (server >= 0) { close(server); }
+    return false;
+  }
+
+  // Send the requests from another thread, so that the server is never held
+  // up by responses that have not been read.
+  std::thread sender{[&] {
+    if (args.empty()) {
+      std::string line{};
+      while (std::getline(std::cin, line)) {
+        line += '\n';
+        if (!writeAll(server, line)) { break; }
+      }
+    } else {
+      std::string request{};
+      for (std::string_view arg : args) {
+        if (!request.empty()) { request += ' '; }
+        request += arg;
+      }
+      request += '\n';
+      writeAll(server, request);
+    }
+    shutdown(server, SHUT_WR);
+  }};
+
+  OutputBuffer buffer{std::cout};
+  std::string input{};
+  char chunk[1 << 16];
+  ssize_t count{};
+  while ((count = read(server, chunk, sizeof(chunk))) != 0) {
+    if (count < 0) {
+      if (errno == EINTR) { continue; }
+      error = systemError("Could not read from " + path);
+      break;
+    }
+    input.append(chunk, static_cast<std::size_t>(count));
+    std::size_t start{0};
+    std::size_t end{};
+    while ((end = input.find('\n', start)) != std::string::npos) {
+      printResponseLine(std::string_view{input}.substr(start, end - start));
+      start = end + 1;
+    }
+    input.erase(0, start);
+  }
+
+  sender.join();
+  close(server);
+  return error.empty();
+} // sendQueries
+
+#else // Windows has no Unix domain sockets in its C library
+
+bool serveQueries(const std::string&, const QueryAnswer&, std::string& error)
+{
+  error = "--serve is not supported on this system";
+  return false;
+} // serveQueries
+
+bool sendQueries(const std::string&, std::span<const std::string_view>,
+                 std::string& error)
+{
+  error = "--connect is not supported on this system";
+  return false;
+} // sendQueries
+
+#endif
+
+} // namespace pascha
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_QUERY_SERVER_H
+#define PASCHA_QUERY_SERVER_H
+
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+
+// A daemon mode for pascha, which answers queries over a Unix domain socket so
+// that frequent callers need not start a process for each calculation. The
+// protocol is line based: each request is a line of the command line options
+// of pascha, and each response is the output pascha would print for them,
+// including any errors, followed by an empty line. Requests may be pipelined,
+// and are answered in order. A response is calculated a block at a time as
+// the client reads it, so that a long one neither holds up the other clients
+// nor is held in memory whole.
+
+namespace pascha
+{
+
+// Append the next block of a response to the string, returning whether there
+// is more of it after the block.
+using QueryResponse = std::function<bool(std::string&)>;
+
+// Start answering the query given as a line of options, returning its
+// response without the empty line that ends it.
+using QueryAnswer = std::function<QueryResponse(std::string_view)>;
+
+// Answer the queries of any number of clients on a socket at path, until
+// interrupted by SIGINT or SIGTERM. A socket left at path by an earlier server
+// is replaced. Returns false with a message in error if the socket can not be
+// set up.
+bool serveQueries(const std::string& path, const QueryAnswer& answer,
+                  std::string& error);
+
+// Send queries to the server at path, writing the responses to std::cout, and
+// the lines of them that are errors to std::cerr. If args is empty, each line
+// of std::cin is sent as a query, otherwise args are sent as a single query.
+// Returns false with a message in error if the server can not be reached.
+bool sendQueries(const std::string& path,
+                 std::span<const std::string_view> args, std::string& error);
+
+} // namespace pascha
+
+#endif // !PASCHA_QUERY_SERVER_H
@@ -0,0 +1,103 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "work_stealing_pool.h"
+
+namespace pascha
+{
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+{
+  if (threads == 0) { threads = 1; }
+  m_queues.reserve(threads);
+  for (std::size_t i{0}; i < threads; ++i) {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+  m_threads.reserve(threads);
+  for (std::size_t i{0}; i < threads; ++i) {
+    m_threads.emplace_back([this, i] { run(i); });
+  }
+} // WorkStealingPool::WorkStealingPool(std::size_t)
+
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_stopping = true;
+  }
+  m_available.notify_all();
+  for (std::thread& thread : m_threads) { thread.join(); }
+} // WorkStealingPool::~WorkStealingPool()
+
+void WorkStealingPool::submit(std::function<void()> task)
+{
+  Queue& queue{*m_queues[m_next]};
+  m_next = (m_next + 1) % m_queues.size();
+  {
+    std::lock_guard lock{queue.mutex};
+    queue.tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard lock{m_mutex};
+    ++m_queued;
+  }
+  m_available.notify_one();
+} // WorkStealingPool::submit(std::function<void()>)
+
+void WorkStealingPool::run(std::size_t index)
+{
+  std::function<void()> task{};
+  while (true) {
+    {
+      std::unique_lock lock{m_mutex};
+      m_available.wait(lock, [this] { return m_queued > 0 || m_stopping; });
+      if (m_queued == 0) { return; } // stopping with nothing left to do
+      --m_queued;
+    }
+    // The count reserved a task, so one is in some queue until it is taken.
+    while (!take(index, task)) {}
+    task();
+    task = nullptr;
+  }
+} // WorkStealingPool::run(std::size_t)
+
+bool WorkStealingPool::take(std::size_t index, std::function<void()>& task)
+{
+  {
+    Queue& own{*m_queues[index]};
+    std::lock_guard lock{own.mutex};
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.front());
+      own.tasks.pop_front();
+      return true;
+    }
+  }
+  for (std::size_t i{1}; i < m_queues.size(); ++i) {
+    Queue& other{*m_queues[(index + i) % m_queues.size()]};
+    std::lock_guard lock{other.mutex};
+    if (!other.tasks.empty()) {
+      task = std::move(other.tasks.back());
+      other.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+} // WorkStealingPool::take(std::size_t, std::function<void()>&)
+
+} // namespace pascha
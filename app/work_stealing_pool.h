@@ -0,0 +1,75 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_WORK_STEALING_POOL_H
+#define PASCHA_WORK_STEALING_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pascha
+{
+
+// A fixed set of worker threads, each with its own queue of tasks. Workers
+// take tasks from the front of their own queue and, when it is empty, steal
+// from the back of the others, so a worker left with slow tasks does not hold
+// up the rest. Tasks are handed out to the queues in turn. The destructor
+// finishes every submitted task before joining the workers.
+class WorkStealingPool
+{
+ public:
+  explicit WorkStealingPool(std::size_t threads);
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool(WorkStealingPool&&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+  ~WorkStealingPool();
+
+  void submit(std::function<void()> task);
+
+ private:
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  }; // struct Queue
+
+  std::vector<std::unique_ptr<Queue>> m_queues{};
+  std::vector<std::thread> m_threads{};
+  std::size_t m_next{};
+
+  // Guards the count of queued tasks, which workers sleep on when it is zero.
+  std::mutex m_mutex{};
+  std::condition_variable m_available{};
+  std::size_t m_queued{};
+  bool m_stopping{};
+
+  void run(std::size_t index);
+  bool take(std::size_t index, std::function<void()>& task);
+}; // class WorkStealingPool
+
+} // namespace pascha
+#endif // !PASCHA_WORK_STEALING_POOL_H
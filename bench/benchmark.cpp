@@ -0,0 +1,224 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+#ifndef PASCHA_BENCH_VERSION
+#define PASCHA_BENCH_VERSION ""
+#endif
+#ifndef PASCHA_BENCH_BUILD_TYPE
+#define PASCHA_BENCH_BUILD_TYPE ""
+#endif
+
+namespace
+{
+using namespace pascha::bench;
+using Clock = std::chrono::steady_clock;
+
+// Call body the given number of times, returning the time taken in
+// nanoseconds.
+double timeCalls(const std::function<void()>& body, std::size_t calls)
+{
+  Clock::time_point start{Clock::now()};
+  for (std::size_t i{0}; i < calls; ++i) { body(); }
+  return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count();
+} // timeCalls
+
+// Summarize the time per operation of each sample.
+Result summarize(std::string_view name, std::uint64_t ops,
+                 std::vector<double> samples)
+{
+  std::sort(samples.begin(), samples.end());
+  std::size_t count{samples.size()};
+
+  Result result{};
+  result.name = name;
+  result.ops_per_run = ops;
+  result.repetitions = count;
+  result.min_ns = samples.front();
+  result.max_ns = samples.back();
+  result.median_ns = count % 2 == 1 ? samples[count / 2]
+                                    : (samples[count / 2 - 1] +
+                                       samples[count / 2]) / 2;
+  result.mean_ns =
+      std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+  double squares{0};
+  for (double sample : samples) {
+    squares += (sample - result.mean_ns) * (sample - result.mean_ns);
+  }
+  result.stddev_ns = count > 1 ? std::sqrt(squares / (count - 1)) : 0;
+  result.ops_per_second = result.median_ns > 0 ? 1e9 / result.median_ns : 0;
+  return result;
+} // summarize
+
+} // anonymous namespace
+
+namespace pascha::bench
+{
+
+void Runner::run(std::string_view name, std::uint64_t ops,
+                 const std::function<void()>& body)
+{
+  if (name.find(m_settings.filter) == std::string_view::npos) { return; }
+  if (m_settings.list) {
+    m_results.push_back(Result{std::string{name}, ops});
+    return;
+  }
+
+  for (std::size_t i{0}; i < m_settings.warmup; ++i) { body(); }
+
+  // Double the calls of body for each sample until they take long enough to
+  // time reliably.
+  std::size_t calls{1};
+  while (timeCalls(body, calls) < m_settings.min_time * 1e9) { calls *= 2; }
+
+  std::vector<double> samples{};
+  for (std::size_t i{0}; i < std::max<std::size_t>(m_settings.repetitions, 1);
+       ++i) {
+    samples.push_back(timeCalls(body, calls) / static_cast<double>(calls) /
+                      static_cast<double>(ops));
+  }
+  m_results.push_back(summarize(name, ops, std::move(samples)));
+} // Runner::run
+
+void Runner::writeText(std::ostream& out) const
+{
+  out << std::left << std::setw(44) << "benchmark" << std::right
+      << std::setw(12) << "ns/op" << std::setw(10) << "stddev"
+      << std::setw(12) << "min" << std::setw(14) << "Mops/s" << '\n';
+  out << std::fixed;
+  for (const Result& result : m_results) {
+    out << std::left << std::setw(44) << result.name << std::right
+        << std::setprecision(2) << std::setw(12) << result.median_ns
+        << std::setw(10) << result.stddev_ns << std::setw(12)
+        << result.min_ns << std::setw(14) << result.ops_per_second / 1e6
+        << '\n';
+  }
+} // Runner::writeText
+
+void Runner::writeJson(std::ostream& out) const
+{
+  // The names of the benchmarks and the context are plain text, which needs
+  // no escaping.
+  out << "{\n"
+      << "  \"context\": {\n"
+      << "    \"program\": \"pascha-bench\",\n"
+      << "    \"version\": \"" << PASCHA_BENCH_VERSION << "\",\n"
+      << "    \"build_type\": \"" << PASCHA_BENCH_BUILD_TYPE << "\",\n"
+#if defined(__VERSION__)
+      << "    \"compiler\": \"" << __VERSION__ << "\",\n"
+#endif
+      << "    \"warmup\": " << m_settings.warmup << ",\n"
+      << "    \"repetitions\": " << m_settings.repetitions << ",\n"
+      << "    \"min_time_s\": " << m_settings.min_time << "\n"
+      << "  },\n"
+      << "  \"benchmarks\": [";
+  out << std::setprecision(4) << std::fixed;
+  for (std::size_t i{0}; i < m_results.size(); ++i) {
+    const Result& result{m_results[i]};
+    out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.name
+        << "\", \"ops_per_run\": " << result.ops_per_run
+        << ", \"repetitions\": " << result.repetitions
+        << ", \"ns_per_op\": {\"min\": " << result.min_ns
+        << ", \"median\": " << result.median_ns
+        << ", \"mean\": " << result.mean_ns
+        << ", \"stddev\": " << result.stddev_ns
+        << ", \"max\": " << result.max_ns
+        << "}, \"ops_per_second\": " << std::setprecision(0)
+        << result.ops_per_second << std::setprecision(4) << "}";
+  }
+  out << "\n  ]\n}\n";
+} // Runner::writeJson
+
+bool writeBaseline(const std::string& path, const std::vector<Result>& results)
+{
+  std::ofstream file{path};
+  file << "# Baseline of pascha-bench, as the best ns per operation of each\n"
+          "# benchmark. Refresh it with the perf-baseline target of the build\n"
+          "# on the machine that runs the performance regression test.\n"
+       << "build_type " << PASCHA_BENCH_BUILD_TYPE << '\n'
+       << std::setprecision(4) << std::fixed;
+  for (const Result& result : results) {
+    file << result.name << ' ' << result.min_ns << '\n';
+  }
+  return static_cast<bool>(file);
+} // writeBaseline
+
+BaselineCheck checkBaseline(const std::string& path,
+                            const std::vector<Result>& results,
+                            double tolerance, std::ostream& out)
+{
+  std::ifstream file{path};
+  if (!file) {
+    out << "Skipped: no baseline in " << path << '\n';
+    return BaselineCheck::skipped;
+  }
+
+  std::string build_type{};
+  std::map<std::string, double, std::less<>> baseline{};
+  std::string line{};
+  while (std::getline(file, line)) {
+    if (line.empty() || line.front() == '#') { continue; }
+    std::istringstream fields{line};
+    std::string name{};
+    fields >> name;
+    if (name == "build_type") {
+      fields >> build_type;
+    } else {
+      fields >> baseline[name];
+    }
+  }
+  if (build_type != PASCHA_BENCH_BUILD_TYPE) {
+    out << "Skipped: the baseline is of the " << build_type
+        << " build type, not " << PASCHA_BENCH_BUILD_TYPE << '\n';
+    return BaselineCheck::skipped;
+  }
+
+  BaselineCheck check{BaselineCheck::skipped};
+  out << std::setprecision(2) << std::fixed;
+  for (const Result& result : results) {
+    auto entry{baseline.find(result.name)};
+    if (entry == baseline.end() || entry->second <= 0) { continue; }
+
+    double change{(result.min_ns / entry->second - 1) * 100};
+    bool regressed{change > tolerance};
+    out << result.name << ": " << result.min_ns << " ns/op against "
+        << entry->second << " (" << std::showpos << change << std::noshowpos
+        << "%)" << (regressed ? " REGRESSED" : "") << '\n';
+    if (regressed) {
+      check = BaselineCheck::regressed;
+    } else if (check == BaselineCheck::skipped) {
+      check = BaselineCheck::passed;
+    }
+  }
+  return check;
+} // checkBaseline
+
+} // namespace pascha::bench
@@ -0,0 +1,125 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_BENCHMARK_H
+#define PASCHA_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// A small harness for timing the hot paths of pascha-lib and pascha-cli
+// without any dependency outside the tree.
+
+namespace pascha::bench
+{
+
+// Keep the compiler from optimizing away the calculation of a value.
+template <typename T>
+inline void keep(const T& value)
+{
+#if defined(__GNUC__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const void* sink{};
+  sink = &value;
+#endif
+} // keep
+
+struct Settings
+{
+  // Untimed runs of each benchmark before the repetitions.
+  std::size_t warmup{2};
+  // Timed samples of each benchmark, from which the statistics are taken.
+  std::size_t repetitions{15};
+  // The least time in seconds for each sample. The body of a benchmark is run
+  // as many times as this takes.
+  double min_time{0.01};
+  // Only benchmarks with names containing this are run.
+  std::string filter{};
+  // Only record the names of the benchmarks rather than running them.
+  bool list{false};
+}; // struct Settings
+
+// The time per operation over the samples of one benchmark.
+struct Result
+{
+  std::string name{};
+  // The operations in each run of the body of the benchmark.
+  std::uint64_t ops_per_run{};
+  std::size_t repetitions{};
+  double min_ns{};
+  double median_ns{};
+  double mean_ns{};
+  double stddev_ns{};
+  double max_ns{};
+  // Operations per second at the median time.
+  double ops_per_second{};
+}; // struct Result
+
+class Runner
+{
+ public:
+  explicit Runner(Settings settings) : m_settings{std::move(settings)} {}
+
+  // Time body, which performs ops operations each time it is called, if name
+  // matches the filter.
+  void run(std::string_view name, std::uint64_t ops,
+           const std::function<void()>& body);
+
+  const std::vector<Result>& results() const { return m_results; }
+
+  void writeText(std::ostream& out) const;
+  void writeJson(std::ostream& out) const;
+
+ private:
+  Settings m_settings;
+  std::vector<Result> m_results{};
+}; // class Runner
+
+// The outcome of checking results against a baseline, which is also the exit
+// status of pascha-bench. CTest counts skipped as neither a pass nor a failure.
+enum class BaselineCheck
+{
+  passed = 0,
+  regressed = 1,
+  skipped = 77,
+}; // enum class BaselineCheck
+
+// Write the best time per operation of each result to a baseline file, along
+// with the build type, since timings of different build types do not compare.
+bool writeBaseline(const std::string& path, const std::vector<Result>& results);
+
+// Compare the best time per operation of each result with the baseline,
+// reporting each to out. It has regressed if any is more than tolerance
+// percent slower. The check is skipped if the baseline can not be read or is
+// of another build type.
+BaselineCheck checkBaseline(const std::string& path,
+                            const std::vector<Result>& results,
+                            double tolerance, std::ostream& out);
+
+} // namespace pascha::bench
+
+#endif // !PASCHA_BENCHMARK_H
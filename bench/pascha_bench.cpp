@@ -0,0 +1,544 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Measures the time per operation and throughput of the hot paths of
+// pascha-lib and pascha-cli: the computus of each method, the calendar
+// conversions, the target dates, chains of decorators, notification through
+// the model and the formatting of CliView. Run with --help for the options.
+
+#include "benchmark.h"
+#include "cli_view.h"
+
+#include "pascha/calculation_methods.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/computus.h"
+#include "pascha/output_calendars.h"
+#include "pascha/output_options.h"
+#include "pascha/pascha_calculator_model.h"
+#include "pascha/static_pipeline.h"
+#include "pascha/target_dates.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <functional>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#ifndef PASCHA_BENCH_TABLE_PATH
+#define PASCHA_BENCH_TABLE_PATH ""
+#endif
+
+namespace
+{
+using namespace pascha;
+using bench::keep;
+using bench::Runner;
+
+// The years each benchmark calculates. They are close to the present, so that
+// the dates are typical of use, and span the 532 year Julian cycle several
+// times.
+constexpr Year kFirstYear{1000};
+constexpr std::size_t kYearCount{4096};
+
+std::vector<Year> makeYears()
+{
+  std::vector<Year> years(kYearCount);
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    years[i] = kFirstYear + static_cast<Year>(i);
+  }
+  return years;
+} // makeYears
+
+// Benchmark a calculation method one year at a time through the interface,
+// for the Julian Day Number, and for the whole span of years in one call.
+void benchMethod(Runner& runner, const std::string& name,
+                 const ICalculationMethod& method, std::span<const Year> years)
+{
+  runner.run(name, years.size(), [&] {
+    for (Year year : years) { keep(method.calculate(year)); }
+  });
+  runner.run(name + "/jdn", years.size(), [&] {
+    for (Year year : years) { keep(method.calculateJdn(year)); }
+  });
+
+  std::vector<Date> dates(years.size());
+  runner.run(name + "/batch", years.size(), [&] {
+    method.calculate(years, dates);
+    keep(dates.front());
+  });
+} // benchMethod
+
+// Benchmark a conversion of each of the inputs.
+template <typename In, typename Convert>
+void benchConversion(Runner& runner, const std::string& name,
+                     const std::vector<In>& inputs, Convert convert)
+{
+  runner.run(name, inputs.size(), [&] {
+    for (const In& input : inputs) { keep(convert(input)); }
+  });
+} // benchConversion
+
+// Benchmark a batch conversion of the whole span of inputs.
+template <typename In, typename Out, typename Convert>
+void benchBatchConversion(Runner& runner, const std::string& name,
+                          const std::vector<In>& inputs, Convert convert)
+{
+  std::vector<Out> outputs(inputs.size());
+  runner.run(name + "/batch", inputs.size(), [&] {
+    convert(std::span<const In>{inputs}, std::span<Out>{outputs});
+    keep(outputs.front());
+  });
+} // benchBatchConversion
+
+void benchComputus(Runner& runner, std::span<const Year> years)
+{
+  runner.run("computus/julian", years.size(), [&] {
+    for (Year year : years) { keep(julianPascha(year)); }
+  });
+  runner.run("computus/gregorian", years.size(), [&] {
+    for (Year year : years) { keep(gregorianPascha(year)); }
+  });
+
+  benchMethod(runner, "method/julian", JulianCalculationMethod{}, years);
+  benchMethod(runner, "method/gregorian", GregorianCalculationMethod{}, years);
+  benchMethod(runner, "method/julian_table", JulianTableCalculationMethod{},
+              years);
+
+  MappedGregorianCalculationMethod mapped{PASCHA_BENCH_TABLE_PATH};
+  if (mapped.mapped()) {
+    benchMethod(runner, "method/gregorian_mapped", mapped, years);
+  }
+} // benchComputus
+
+void benchConversions(Runner& runner, std::span<const Year> years)
+{
+  // A date in every month, and the Julian Day Numbers of them.
+  std::vector<Date> dates(years.size());
+  std::vector<CalcInt> jdns(years.size());
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    dates[i] = Date{years[i], static_cast<Month>(i % 12 + 1),
+                    static_cast<Day>(i % 28 + 1)};
+    jdns[i] = gregorianToJdn(dates[i]);
+  }
+
+  benchConversion(runner, "conversion/gregorian_to_jdn", dates,
+                  [](const Date& date) { return gregorianToJdn(date); });
+  benchConversion(runner, "conversion/julian_to_jdn", dates,
+                  [](const Date& date) { return julianToJdn(date); });
+  benchConversion(runner, "conversion/rev_julian_to_jdn", dates,
+                  [](const Date& date) { return revJulianToJdn(date); });
+  benchConversion(runner, "conversion/jdn_to_gregorian", jdns,
+                  [](CalcInt jdn) { return jdnToGregorian(jdn); });
+  benchConversion(runner, "conversion/jdn_to_julian", jdns,
+                  [](CalcInt jdn) { return jdnToJulian(jdn); });
+  benchConversion(runner, "conversion/jdn_to_rev_julian", jdns,
+                  [](CalcInt jdn) { return jdnToRevJulian(jdn); });
+  benchConversion(runner, "conversion/gregorian_to_julian", dates,
+                  [](const Date& date) { return gregorianToJulian(date); });
+  benchConversion(runner, "conversion/julian_to_gregorian", dates,
+                  [](const Date& date) { return julianToGregorian(date); });
+  benchConversion(runner, "conversion/gregorian_to_rev_julian", dates,
+                  [](const Date& date) { return gregorianToRevJulian(date); });
+  benchConversion(runner, "conversion/rev_julian_to_gregorian", dates,
+                  [](const Date& date) { return revJulianToGregorian(date); });
+  benchConversion(runner, "conversion/check_gregorian_jdn", jdns,
+                  [](CalcInt jdn) { return checkGregorianJdn(jdn); });
+  benchConversion(runner, "conversion/julian_gregorian_drift",
+                  std::vector<Year>(years.begin(), years.end()),
+                  [](Year year) { return julianGregorianDrift(year); });
+
+  benchBatchConversion<Date, CalcInt>(
+      runner, "conversion/gregorian_to_jdn", dates,
+      [](auto in, auto out) { gregorianToJdn(in, out); });
+  benchBatchConversion<Date, CalcInt>(
+      runner, "conversion/julian_to_jdn", dates,
+      [](auto in, auto out) { julianToJdn(in, out); });
+  benchBatchConversion<Date, CalcInt>(
+      runner, "conversion/rev_julian_to_jdn", dates,
+      [](auto in, auto out) { revJulianToJdn(in, out); });
+  benchBatchConversion<CalcInt, Date>(
+      runner, "conversion/jdn_to_gregorian", jdns,
+      [](auto in, auto out) { jdnToGregorian(in, out); });
+  benchBatchConversion<CalcInt, Date>(
+      runner, "conversion/jdn_to_julian", jdns,
+      [](auto in, auto out) { jdnToJulian(in, out); });
+  benchBatchConversion<CalcInt, Date>(
+      runner, "conversion/jdn_to_rev_julian", jdns,
+      [](auto in, auto out) { jdnToRevJulian(in, out); });
+  benchBatchConversion<Date, Date>(
+      runner, "conversion/gregorian_to_julian", dates,
+      [](auto in, auto out) { gregorianToJulian(in, out); });
+  benchBatchConversion<Date, Date>(
+      runner, "conversion/julian_to_gregorian", dates,
+      [](auto in, auto out) { julianToGregorian(in, out); });
+  benchBatchConversion<Date, Date>(
+      runner, "conversion/gregorian_to_rev_julian", dates,
+      [](auto in, auto out) { gregorianToRevJulian(in, out); });
+  benchBatchConversion<Date, Date>(
+      runner, "conversion/rev_julian_to_gregorian", dates,
+      [](auto in, auto out) { revJulianToGregorian(in, out); });
+} // benchConversions
+
+void benchTargetDates(Runner& runner, std::span<const Year> years)
+{
+  auto julian{std::make_shared<JulianCalculationMethod>()};
+  benchMethod(runner, "target/meatfare", Meatfare{julian}, years);
+  benchMethod(runner, "target/cheesefare", Cheesefare{julian}, years);
+  benchMethod(runner, "target/ash_wednesday", AshWednesday{julian}, years);
+  benchMethod(runner, "target/midfeast_pentecost", MidfeastPentecost{julian},
+              years);
+  benchMethod(runner, "target/leavetaking_pascha", LeavetakingPascha{julian},
+              years);
+  benchMethod(runner, "target/ascension", Ascension{julian}, years);
+  benchMethod(runner, "target/pentecost", Pentecost{julian}, years);
+} // benchTargetDates
+
+void benchChains(Runner& runner, std::span<const Year> years)
+{
+  // Decorators that pass the date through unchanged, to measure the cost of
+  // each level of the chain.
+  for (int depth : {0, 1, 2, 4, 8}) {
+    std::shared_ptr<ICalculationMethod> method{
+        std::make_shared<JulianCalculationMethod>()};
+    for (int i{0}; i < depth; ++i) {
+      method = std::make_shared<GregorianOutputCalendar>(method);
+    }
+    benchMethod(runner, "chain/depth_" + std::to_string(depth), *method,
+                years);
+  }
+
+  // The longest chain the controller builds, against the static pipeline it
+  // is replaced with.
+  std::shared_ptr<ICalculationMethod> chain{
+      std::make_shared<JulianCalculationMethod>()};
+  chain = std::make_shared<Pentecost>(chain);
+  chain = std::make_shared<JulianOutputCalendar>(chain);
+  chain = std::make_shared<ByzantineDate>(chain);
+  benchMethod(runner, "chain/pentecost_julian_byzantine", *chain, years);
+
+  std::shared_ptr<ICalculationMethod> pipeline{makeStaticPipeline(
+      e_calculation_method::julian, e_target_output::pentecost,
+      e_output_calendar::julian, true)};
+  benchMethod(runner, "pipeline/pentecost_julian_byzantine", *pipeline,
+              years);
+} // benchChains
+
+// Counts the dates it is notified of.
+class CountingObserver : public IObserver
+{
+ public:
+  void update(const Date&) override { ++m_count; }
+  void update(Weeks) override { ++m_count; }
+  void update(Days) override { ++m_count; }
+  void update(std::string_view) override { ++m_count; }
+
+ private:
+  std::size_t m_count{};
+}; // class CountingObserver
+
+void benchModel(Runner& runner, std::span<const Year> years)
+{
+  std::vector<Date> dates(years.size());
+  JulianCalculationMethod{}.calculate(years, dates);
+
+  for (std::size_t count : {1, 4}) {
+    PaschaCalculatorModel model{};
+    std::vector<CountingObserver> observers(count);
+    for (CountingObserver& observer : observers) {
+      model.addObserver(observer);
+    }
+    runner.run("model/notify/observers_" + std::to_string(count), dates.size(),
+               [&] {
+                 for (const Date& date : dates) { model.notify(date); }
+               });
+  }
+
+  PaschaCalculatorModel model{};
+  CountingObserver observer{};
+  model.addObserver(observer);
+  model.setCalculationMethod(std::make_shared<JulianCalculationMethod>());
+  runner.run("model/calculate", years.size(), [&] {
+    for (Year year : years) { model.calculate(year); }
+  });
+  runner.run("model/calculate/batch", years.size(),
+             [&] { model.calculate(years); });
+
+  // The same number of years, across the end of the range of the Julian
+  // calendar, so that half of them are errors.
+  std::vector<Year> limit_years(years.size());
+  for (std::size_t i{0}; i < limit_years.size(); ++i) {
+    limit_years[i] = kJulianMaxYear - static_cast<Year>(years.size() / 2 - i);
+  }
+  runner.run("model/calculate/batch_out_of_range", limit_years.size(),
+             [&] { model.calculate(limit_years); });
+} // benchModel
+
+// Runs the benchmarks of CliView from inside createView, where its output is
+// set up as it is for the calculation.
+class BenchController : public IController
+{
+ public:
+  explicit BenchController(std::function<void()> body) : m_body{body} {}
+
+  void calculate(const CalculationOptions&) const override { m_body(); }
+  void addView(IView&) override {}
+  void removeView(IView&) override {}
+  void start() override {}
+
+ private:
+  std::function<void()> m_body;
+}; // class BenchController
+
+// Discards everything written to it.
+class NullBuffer : public std::streambuf
+{
+ protected:
+  int_type overflow(int_type ch) override { return ch; }
+  std::streamsize xsputn(const char*, std::streamsize count) override
+  {
+    return count;
+  }
+}; // class NullBuffer
+
+void benchView(Runner& runner, std::span<const Year> years)
+{
+  std::vector<Date> dates(years.size());
+  JulianCalculationMethod{}.calculate(years, dates);
+
+  PaschaCalculatorModel model{};
+  BenchController controller{[&] {
+    runner.run("view/update_date", dates.size(), [&] {
+      for (const Date& date : dates) { model.notify(date); }
+    });
+    runner.run("view/update_days", dates.size(), [&] {
+      for (const Date& date : dates) { model.notify(Days{date.day}); }
+    });
+    runner.run("view/update_block", dates.size(), [&] {
+      std::span<const Date> all{dates};
+      for (std::size_t first{}; first < dates.size(); first += 4096) {
+        std::size_t count{std::min<std::size_t>(4096, dates.size() - first)};
+        model.notify(all.subspan(first, count),
+                     DatesMetadata{years.subspan(first, count),
+                                   e_target_output::pascha});
+      }
+    });
+  }};
+
+  // Print the year, as for a range of years.
+  std::array<char*, 3> argv{const_cast<char*>("pascha-bench"),
+                            const_cast<char*>("-y"),
+                            const_cast<char*>("2024")};
+  CliView view{controller, model, static_cast<int>(argv.size()), argv.data()};
+
+  NullBuffer null{};
+  std::streambuf* original{std::cout.rdbuf(&null)};
+  optind = 1;
+  view.createView();
+  std::cout.rdbuf(original);
+} // benchView
+
+// The workload of the performance regression test: the full Paschalion, which
+// is Pascha and every target date, for each of the first million years. It is
+// calculated as the controller calculates a range, deriving each target date
+// from Pascha calculated for a block of years at once.
+constexpr Year kPaschalionYears{1000000};
+constexpr std::size_t kPaschalionBlock{4096};
+
+void benchPaschalion(Runner& runner)
+{
+  std::vector<Year> years(kPaschalionYears);
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    years[i] = static_cast<Year>(i) + 1;
+  }
+
+  struct Workload
+  {
+    const char* name;
+    ECalculationMethod method;
+    EOutputCalendar calendar;
+  };
+  for (const Workload& workload : {
+           Workload{"paschalion/julian/julian", e_calculation_method::julian,
+                    e_output_calendar::julian},
+           Workload{"paschalion/julian/gregorian",
+                    e_calculation_method::julian,
+                    e_output_calendar::gregorian},
+           Workload{"paschalion/julian/rev_julian",
+                    e_calculation_method::julian,
+                    e_output_calendar::rev_julian},
+           Workload{"paschalion/gregorian/gregorian",
+                    e_calculation_method::gregorian,
+                    e_output_calendar::gregorian},
+       }) {
+    std::shared_ptr<ICalculationMethod> pascha{
+        makeStaticPipeline(workload.method, e_target_output::pascha,
+                           e_output_calendar::gregorian, false)};
+    std::vector<PipelineFinish> finishes{};
+    for (ETargetOutput target :
+         {e_target_output::pascha, e_target_output::meatfare,
+          e_target_output::cheesefare, e_target_output::ashWednesday,
+          e_target_output::midfeastPentecost,
+          e_target_output::leavetakingPascha, e_target_output::ascension,
+          e_target_output::pentecost}) {
+      finishes.push_back(
+          staticPipelineFinish(target, workload.calendar, false));
+    }
+
+    std::vector<Date> paschas(kPaschalionBlock);
+    runner.run(workload.name, years.size(), [&] {
+      std::span<const Year> remaining{years};
+      while (!remaining.empty()) {
+        std::span<const Year> block{
+            remaining.first(std::min(kPaschalionBlock, remaining.size()))};
+        remaining = remaining.subspan(block.size());
+
+        pascha->calculate(block, paschas);
+        for (std::size_t i{0}; i < block.size(); ++i) {
+          for (PipelineFinish finish : finishes) { keep(finish(paschas[i])); }
+        }
+      }
+    });
+  }
+} // benchPaschalion
+
+void printUsage(char* argv[])
+{
+  std::cout
+      << "Usage: " << argv[0]
+      << " [--json] [--filter <TEXT>] [--repetitions <N>] [--warmup <N>]\n"
+         "       [--min-time <SECONDS>] [--list] [--baseline <FILE>]\n"
+         "       [--tolerance <PERCENT>] [--write-baseline <FILE>]\n"
+      << "  --json writes the results as JSON rather than a table\n"
+      << "  --filter only runs the benchmarks with TEXT in their names\n"
+      << "  --repetitions sets the number of timed samples of each benchmark\n"
+      << "  --warmup sets the number of untimed runs before the samples\n"
+      << "  --min-time sets the least time for each sample\n"
+      << "  --list lists the benchmarks without running them\n"
+      << "  --baseline fails if any benchmark in FILE is more than PERCENT\n"
+         "    slower than it was, 10 by default\n"
+      << "  --write-baseline writes the results to FILE for --baseline\n";
+} // printUsage
+
+// Options that only have a long form are given values past any character.
+namespace e_long_option
+{
+
+enum
+{
+  json = 256,
+  filter,
+  repetitions,
+  warmup,
+  min_time,
+  list,
+  baseline,
+  tolerance,
+  write_baseline,
+}; // enum
+
+} // namespace e_long_option
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  static const option long_options[]{
+      {"json", no_argument, nullptr, e_long_option::json},
+      {"filter", required_argument, nullptr, e_long_option::filter},
+      {"repetitions", required_argument, nullptr, e_long_option::repetitions},
+      {"warmup", required_argument, nullptr, e_long_option::warmup},
+      {"min-time", required_argument, nullptr, e_long_option::min_time},
+      {"list", no_argument, nullptr, e_long_option::list},
+      {"baseline", required_argument, nullptr, e_long_option::baseline},
+      {"tolerance", required_argument, nullptr, e_long_option::tolerance},
+      {"write-baseline", required_argument, nullptr,
+       e_long_option::write_baseline},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, 0, nullptr, 0},
+  };
+
+  bench::Settings settings{};
+  bool json{false};
+  std::string baseline{};
+  double tolerance{10};
+  std::string write_baseline{};
+  int opt{};
+  while ((opt = getopt_long(argc, argv, ":h", long_options, nullptr)) != -1) {
+    switch (opt) {
+      case e_long_option::json: json = true; break;
+      case e_long_option::filter: settings.filter = optarg; break;
+      case e_long_option::repetitions:
+        settings.repetitions = std::strtoul(optarg, nullptr, 10);
+        break;
+      case e_long_option::warmup:
+        settings.warmup = std::strtoul(optarg, nullptr, 10);
+        break;
+      case e_long_option::min_time:
+        settings.min_time = std::strtod(optarg, nullptr);
+        break;
+      case e_long_option::list: settings.list = true; break;
+      case e_long_option::baseline: baseline = optarg; break;
+      case e_long_option::tolerance:
+        tolerance = std::strtod(optarg, nullptr);
+        break;
+      case e_long_option::write_baseline: write_baseline = optarg; break;
+      case 'h': printUsage(argv); return EXIT_SUCCESS;
+      default: printUsage(argv); return EXIT_FAILURE;
+    }
+  }
+
+  Runner runner{settings};
+  std::vector<Year> years{makeYears()};
+  benchComputus(runner, years);
+  benchConversions(runner, years);
+  benchTargetDates(runner, years);
+  benchChains(runner, years);
+  benchModel(runner, years);
+  benchView(runner, years);
+  benchPaschalion(runner);
+
+  if (!write_baseline.empty() && !settings.list) {
+    if (!bench::writeBaseline(write_baseline, runner.results())) {
+      std::cerr << "Error: Could not write " << write_baseline << '\n';
+      return EXIT_FAILURE;
+    }
+  }
+  if (!baseline.empty() && !settings.list) {
+    runner.writeText(std::cout);
+    return static_cast<int>(bench::checkBaseline(baseline, runner.results(),
+                                                 tolerance, std::cout));
+  }
+
+  if (settings.list) {
+    for (const bench::Result& result : runner.results()) {
+      std::cout << result.name << '\n';
+    }
+  } else if (json) {
+    runner.writeJson(std::cout);
+  } else {
+    runner.writeText(std::cout);
+  }
+  return EXIT_SUCCESS;
+} // main
@@ -33,7 +33,10 @@ class CalculationMethodDecorator : public ICalculationMethod
  public:
   CalculationMethodDecorator(std::shared_ptr<ICalculationMethod>);
   virtual ~CalculationMethodDecorator();
-  virtual Date calculate(Year) const = 0;
+  virtual Checked<Date> tryCalculate(Year) const = 0;
+  virtual Checked<CalcInt> tryCalculateJdn(Year) const = 0;
+  virtual std::size_t tryCalculate(std::span<const Year>, std::span<Date>,
+                                   std::span<EConversionError>) const = 0;
 
  protected:
   const ICalculationMethod& calculation_method() const
@@ -23,6 +23,10 @@
 
 #include "i_calculation_method.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
 namespace pascha
 {
 
@@ -30,16 +34,61 @@ class JulianCalculationMethod : public ICalculationMethod
 {
  public:
   ~JulianCalculationMethod() = default;
-  Date calculate(Year year) const override;
+  Checked<Date> tryCalculate(Year year) const override;
+  Checked<CalcInt> tryCalculateJdn(Year year) const override;
+  std::size_t tryCalculate(std::span<const Year> years, std::span<Date> dates,
+                           std::span<EConversionError> errors) const override;
 }; // class JulianCalculationMethod
 
 class GregorianCalculationMethod : public ICalculationMethod
 {
  public:
   ~GregorianCalculationMethod() = default;
-  Date calculate(Year year) const override;
+  Checked<Date> tryCalculate(Year year) const override;
+  std::size_t tryCalculate(std::span<const Year> years, std::span<Date> dates,
+                           std::span<EConversionError> errors) const override;
 }; // class GregorianCalculationMethod
 
+// The same as JulianCalculationMethod, but looks up the date of Pascha in the
+// 532 year cycle of the Julian Paschalion instead of calculating the computus,
+// and projects it onto the Gregorian calendar by the drift between the
+// calendars.
+class JulianTableCalculationMethod : public ICalculationMethod
+{
+ public:
+  ~JulianTableCalculationMethod() = default;
+  Checked<Date> tryCalculate(Year year) const override;
+  std::size_t tryCalculate(std::span<const Year> years, std::span<Date> dates,
+                           std::span<EConversionError> errors) const override;
+}; // class JulianTableCalculationMethod
+
+// The same as GregorianCalculationMethod, but looks up the date of Pascha in
+// a memory mapped table of the 5,700,000 year cycle of the Gregorian
+// Paschalion (see gregorian_table.h). If the table file is missing or fails
+// its checks, or for negative years, the computus is calculated instead.
+class MappedGregorianCalculationMethod : public ICalculationMethod
+{
+ public:
+  MappedGregorianCalculationMethod();
+  explicit MappedGregorianCalculationMethod(const std::string& path);
+  MappedGregorianCalculationMethod(const MappedGregorianCalculationMethod&) =
+      delete;
+  MappedGregorianCalculationMethod&
+      operator=(const MappedGregorianCalculationMethod&) = delete;
+  ~MappedGregorianCalculationMethod();
+  Checked<Date> tryCalculate(Year year) const override;
+  std::size_t tryCalculate(std::span<const Year> years, std::span<Date> dates,
+                           std::span<EConversionError> errors) const override;
+  // Whether the table is mapped, rather than falling back to the computus.
+  bool mapped() const { return m_table != nullptr; }
+
+ private:
+  GregorianCalculationMethod m_computus{};
+  const std::uint8_t* m_table{nullptr};
+  void* m_mapping{nullptr};
+  std::size_t m_mapping_size{0};
+}; // class MappedGregorianCalculationMethod
+
 } // namespace pascha
 
 #endif // !PASCHA_CALCULATION_METHODS_H
@@ -23,6 +23,9 @@
 
 #include "typedefs.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <vector>
 
 namespace pascha
@@ -33,6 +36,16 @@ using EOutputCalendar = int;
 using ETargetOutput = int;
 using EOutputOption = int;
 
+// An inclusive range of years from `from` to `to`, visiting every `step`th
+// year. The range runs backwards when `from` is greater than `to`. A single
+// year is represented by from == to.
+struct YearRange
+{
+  Year from;
+  Year to;
+  Year step{1};
+}; // struct YearRange
+
 struct CalculationOptions
 {
   ECalculationMethod calculation_method;
@@ -40,6 +53,21 @@ struct CalculationOptions
   EOutputCalendar output_calendar;
   std::vector<EOutputOption> options;
   Year year;
+  // When not empty, the years to calculate in order, overriding `year`.
+  std::vector<YearRange> years;
+  // The number of threads to calculate the years with. Output is in the same
+  // order whatever the number of threads.
+  std::size_t threads{1};
+  // When not 0, only the years whose Pascha falls on this month and day of
+  // the output calendar are calculated, out of the years given.
+  Month search_month{0};
+  Day search_day{0};
+  // When set, only the years in which Julian Pascha is this many weeks after
+  // Gregorian Pascha are calculated, out of the years given.
+  std::optional<std::int64_t> search_weeks{};
+  // Whether to count the years of each range by their date of Pascha, rather
+  // than calculating each year.
+  bool statistics{false};
 }; // struct CalculationOptions
 
 namespace e_calculation_method
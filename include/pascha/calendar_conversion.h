@@ -18,19 +18,446 @@
 // Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
 // reporting.
 
+
 #ifndef PASCHA_CALENDAR_CONVERSION_H
 #define PASCHA_CALENDAR_CONVERSION_H
 
+#include "conversion_error.h"
 #include "date.h"
 
+#include <cstddef>
+#include <span>
+
+// The conversions are constexpr, so that they can be evaluated at compile time
+// for years within range. Out of range years throw std::overflow_error, which
+// is a compile error when constant evaluated, or are returned as an error by
+// the try functions.
+
 namespace pascha
 {
 
-CalcInt gregorianToJdn(const Date& date);
-Date gregorianToJulian(const Date& date);
-Date julianToGregorian(const Date& date);
-Date gregorianToRevJulian(const Date& date);
-Date revJulianToGregorian(const Date& date);
+// Overflow constants
+// These are only valid when CalcInt = std::int64_t
+inline constexpr CalcInt kGregorianMaxYear{25252734927761841};
+inline constexpr CalcInt kJulianMaxYear{25252216391110347};
+inline constexpr CalcInt kRevJulianMaxYear{25252754133231976};
+inline constexpr CalcInt kRevJulianMaxJdn{2305837553489651559};
+
+// To prevent invalid dates with Byzantine Calendar
+inline constexpr CalcInt kGregorianMinYear{-5508};
+inline constexpr CalcInt kJulianMinYear{-5508};
+inline constexpr CalcInt kRevJulianMinYear{-5508};
+
+// Division rounding toward negative infinity, and its non-negative remainder,
+// for a positive divisor. Built-in division rounds toward zero, so a negative
+// dividend that is not a multiple of the divisor is corrected by the result of
+// a comparison rather than a branch on its sign. These keep the conversions
+// free of branches that depend on the sign of the year.
+constexpr CalcInt floorDiv(CalcInt dividend, CalcInt divisor)
+{
+  return dividend / divisor - (dividend % divisor < 0);
+} // floorDiv
+
+constexpr CalcInt floorMod(CalcInt dividend, CalcInt divisor)
+{
+  CalcInt remainder{dividend % divisor};
+  return remainder + divisor * (remainder < 0);
+} // floorMod
+
+// The conversions without their range checks. These are shared by the checked
+// functions below and the batch functions, which check a whole span before
+// converting it. The range must be checked before calling them.
+namespace unchecked
+{
+
+constexpr CalcInt gregorianToJdn(const Date& date)
+{
+  // Calculate the number of 400 year cycles, and the year within the cycle
+  CalcInt cycles{floorDiv(date.year, 400)};
+  CalcInt y{floorMod(date.year, 400)};
+
+  // Treat months prior to leap day as if they were in the previous year
+  CalcInt early{date.month < 3};
+  CalcInt m{date.month + 12 * early};
+  y -= early;
+
+  // Add contribution from number of leap years, less the leap years skipped
+  // when divisible by 100 but not by 400
+  CalcInt jdn{365 * y + floorDiv(y, 4) - floorDiv(y, 100) + floorDiv(y, 400)};
+
+  // Add contribution from number of months and current day in month
+  jdn = jdn + 153 * (m + 1) / 5 + date.day - 123;
+
+  // Add base contribution for days prior to 1/1/1
+  // and the total number of unaccounted cycles
+  return jdn + 1721120 + 146097 * cycles;
+} // gregorianToJdn
+
+constexpr CalcInt julianToJdn(const Date& date)
+{
+  // Calculate the number of 4 year cycles, and the year within the cycle
+  CalcInt cycles{floorDiv(date.year, 4)};
+  CalcInt y{floorMod(date.year, 4)};
+
+  // Treat months prior to leap day as if they were in the previous year
+  CalcInt early{date.month < 3};
+  CalcInt m{date.month + 12 * early};
+  y -= early;
+
+  // Add contribution from number of leap years
+  CalcInt jdn{365 * y + floorDiv(y, 4)};
+
+  // Add contribution from number of months and current day in month
+  jdn = jdn + 153 * (m + 1) / 5 + date.day - 123;
+
+  // Add base contribution for days prior to 1/1/1
+  // and the total number of unaccounted cycles
+  return jdn + 1721118 + 1461 * cycles;
+} // julianToJdn
+
+constexpr CalcInt revJulianToJdn(const Date& date)
+{
+  // Treat months prior to leap day as if they were in the previous year
+  CalcInt early{date.month < 3};
+  CalcInt m{date.month + 12 * early};
+  CalcInt y{date.year - early};
+
+  // Add contribution from number of leap years
+  CalcInt jdn{365 * y + floorDiv(y, 4)};
+
+  // Skip leap years divisible by 100, but retain those with a remainder of 200
+  // or 600 after dividing by 900
+  jdn = jdn - floorDiv(y, 100) + floorDiv(y + 300, 900) +
+        floorDiv(y + 700, 900);
+
+  // Add contribution from number of months and current day in month
+  jdn = jdn + floorDiv(153 * (m + 1), 5) + date.day - 123;
+
+  // Add base contribution for days prior to 1/1/1
+  return jdn + 1721120;
+} // revJulianToJdn
+
+constexpr Date jdnToRevJulian(CalcInt jdn)
+{
+  // Remove contribution prior to 1/1/1
+  CalcInt day{jdn - 1721120};
+
+  // Calculate the number of cycles of 900 years and remove their
+  // contribution, so that the steps below cannot overflow
+  CalcInt cycles{floorDiv(day, 328718)};
+  day = floorMod(day, 328718);
+
+  // Adjustments based on Revised Julian skipped leap years: the base number of
+  // leap days, less the years with a remainder of 200 or 600 after division by
+  // 900, which keep theirs
+  CalcInt a{(9 * day + 2) / 328718};
+  day = day + a - (a + 3) / 9 - (a + 7) / 9;
+
+  // Calculating number of years contained in current day value
+  // and removing their contribution from day
+  CalcInt year{(4 * day + 3) / 1461};
+  day = day - 1461 * year / 4;
+
+  // Calculating number of months contained in current day value
+  // and removing their contribution from day
+  CalcInt month{(5 * day + 2) / 153};
+  day = day - (153 * month + 2) / 5 + 1;
+
+  // Adjusting month and year values to have year start in january
+  // rather than divided pre- and post-leap day
+  month += 3;
+  CalcInt january{month > 12};
+  month -= 12 * january;
+  year += january;
+
+  // Adding contribution of 900 year cycles to the year
+  year = year + 900 * cycles;
+
+  // Setting output
+  Date date{};
+  date.year = year;
+  date.month = month;
+  date.day = day;
+  return date;
+} // jdnToRevJulian
+
+} // namespace unchecked
+
+// The following functions calculate the Julian Day Number (JDN) from a given
+// calendar date. This is used as a fixed point to convert between calendars.
+// Each try function returns the error of a date out of range, which the
+// function of the same name without try throws.
+
+constexpr Checked<CalcInt> tryGregorianToJdn(const Date& date)
+{
+  if (date.year > kGregorianMaxYear || date.year < kGregorianMinYear) {
+    return {0, e_conversion_error::gregorian_year};
+  }
+  return {unchecked::gregorianToJdn(date)};
+} // tryGregorianToJdn
+
+constexpr Checked<CalcInt> tryJulianToJdn(const Date& date)
+{
+  if (date.year > kJulianMaxYear || date.year < kJulianMinYear) {
+    return {0, e_conversion_error::julian_year};
+  }
+  return {unchecked::julianToJdn(date)};
+} // tryJulianToJdn
+
+constexpr Checked<CalcInt> tryRevJulianToJdn(const Date& date)
+{
+  if (date.year > kRevJulianMaxYear || date.year < kRevJulianMinYear) {
+    return {0, e_conversion_error::rev_julian_year};
+  }
+  return {unchecked::revJulianToJdn(date)};
+} // tryRevJulianToJdn
+
+constexpr CalcInt gregorianToJdn(const Date& date)
+{
+  return tryGregorianToJdn(date).valueOrThrow();
+} // gregorianToJdn
+
+constexpr CalcInt julianToJdn(const Date& date)
+{
+  return tryJulianToJdn(date).valueOrThrow();
+} // julianToJdn
+
+constexpr CalcInt revJulianToJdn(const Date& date)
+{
+  return tryRevJulianToJdn(date).valueOrThrow();
+} // revJulianToJdn
+
+// The following functions calculate the calendar date from a given Julian Day
+// Number (JDN).
+
+constexpr Date jdnToGregorian(CalcInt jdn)
+{
+  // Remove contribution prior to 1/1/1
+  CalcInt day{jdn - 1721120};
+
+  // Calculate the number of cycles of 400 years
+  // and remove their contribution
+  CalcInt cycles{floorDiv(day, 146097)};
+  day = floorMod(day, 146097);
+
+  // Adjusting removal of cycles due to rounding
+  CalcInt a{(4 * day + 3) / 146097};
+  day = day + a - a / 4;
+
+  // Calculating number of years contained in current day value
+  // and removing their contribution from day
+  CalcInt year{(4 * day + 3) / 1461};
+  day = day - 1461 * year / 4;
+
+  // Calculating number of months contained in current day value
+  // and removing their contribution from day
+  CalcInt month{(5 * day + 2) / 153};
+  day = day - (153 * month + 2) / 5 + 1;
+
+  // Adjusting month and year values to have year start in january
+  // rather than divided pre- and post-leap day
+  month += 3;
+  CalcInt january{month > 12};
+  month -= 12 * january;
+  year += january;
+
+  // Adding contribution of 400 year cycles to the year
+  year = year + 400 * cycles;
+
+  // Setting output
+  Date date{};
+  date.year = year;
+  date.month = month;
+  date.day = day;
+  return date;
+} // jdnToGregorian
+
+constexpr Date jdnToJulian(CalcInt jdn)
+{
+  // Remove contribution prior to 1/1/1
+  CalcInt day{jdn - 1721118};
+
+  // Calculate the number of cycles of 4 years
+  // and remove their contribution
+  CalcInt cycles{floorDiv(day, 1461)};
+  day = floorMod(day, 1461);
+
+  // Calculating number of years contained in current day value
+  // and removing their contribution from day
+  CalcInt year{(4 * day + 3) / 1461};
+  day = day - 1461 * year / 4;
+
+  // Calculating number of months contained in current day value
+  // and removing their contribution from day
+  CalcInt month{(5 * day + 2) / 153};
+  day = day - (153 * month + 2) / 5 + 1;
+
+  // Adjusting month and year values to have year start in january
+  // rather than divided pre- and post-leap day
+  month += 3;
+  CalcInt january{month > 12};
+  month -= 12 * january;
+  year += january;
+
+  // Adding contribution of 4 year cycles to the year
+  year = year + 4 * cycles;
+
+  // Setting output
+  Date date{};
+  date.year = year;
+  date.month = month;
+  date.day = day;
+  return date;
+} // jdnToJulian
+
+constexpr Checked<Date> tryJdnToRevJulian(CalcInt jdn)
+{
+  if (jdn > kRevJulianMaxJdn) {
+    return {{}, e_conversion_error::rev_julian_jdn};
+  }
+  return {unchecked::jdnToRevJulian(jdn)};
+} // tryJdnToRevJulian
+
+constexpr Date jdnToRevJulian(CalcInt jdn)
+{
+  return tryJdnToRevJulian(jdn).valueOrThrow();
+} // jdnToRevJulian
+
+// The range of Julian Day Numbers of dates within the range of the Gregorian
+// calendar, which gregorianToJdn accepts.
+inline constexpr CalcInt kGregorianMinJdn{
+    gregorianToJdn(Date{kGregorianMinYear, 1, 1})};
+inline constexpr CalcInt kGregorianMaxJdn{
+    gregorianToJdn(Date{kGregorianMaxYear, 12, 31})};
+
+// Check that a JDN is of a date within the range of the Gregorian calendar,
+// with the same error that gregorianToJdn would give for that date.
+constexpr Checked<CalcInt> tryCheckGregorianJdn(CalcInt jdn)
+{
+  if (jdn > kGregorianMaxJdn || jdn < kGregorianMinJdn) {
+    return {jdn, e_conversion_error::gregorian_year};
+  }
+  return {jdn};
+} // tryCheckGregorianJdn
+
+constexpr CalcInt checkGregorianJdn(CalcInt jdn)
+{
+  return tryCheckGregorianJdn(jdn).valueOrThrow();
+} // checkGregorianJdn
+
+// The following functions convert a date between calendars.
+
+constexpr Checked<Date> tryGregorianToJulian(const Date& date)
+{
+  Checked<CalcInt> jdn{tryGregorianToJdn(date)};
+  if (!jdn) { return {{}, jdn.error}; }
+  return {jdnToJulian(*jdn)};
+} // tryGregorianToJulian
+
+constexpr Checked<Date> tryJulianToGregorian(const Date& date)
+{
+  Checked<CalcInt> jdn{tryJulianToJdn(date)};
+  if (!jdn) { return {{}, jdn.error}; }
+  return {jdnToGregorian(*jdn)};
+} // tryJulianToGregorian
+
+constexpr Checked<Date> tryGregorianToRevJulian(const Date& date)
+{
+  Checked<CalcInt> jdn{tryGregorianToJdn(date)};
+  if (!jdn) { return {{}, jdn.error}; }
+  return tryJdnToRevJulian(*jdn);
+} // tryGregorianToRevJulian
+
+constexpr Checked<Date> tryRevJulianToGregorian(const Date& date)
+{
+  Checked<CalcInt> jdn{tryRevJulianToJdn(date)};
+  if (!jdn) { return {{}, jdn.error}; }
+  return {jdnToGregorian(*jdn)};
+} // tryRevJulianToGregorian
+
+constexpr Date gregorianToJulian(const Date& date)
+{
+  return tryGregorianToJulian(date).valueOrThrow();
+} // gregorianToJulian
+
+constexpr Date julianToGregorian(const Date& date)
+{
+  return tryJulianToGregorian(date).valueOrThrow();
+} // julianToGregorian
+
+constexpr Date gregorianToRevJulian(const Date& date)
+{
+  return tryGregorianToRevJulian(date).valueOrThrow();
+} // gregorianToRevJulian
+
+constexpr Date revJulianToGregorian(const Date& date)
+{
+  return tryRevJulianToGregorian(date).valueOrThrow();
+} // revJulianToGregorian
+
+// The following functions convert each element of a span, storing the result
+// in the element of the output span with the same index. The output must be
+// at least as large as the input, and may be the same span for the
+// conversions between calendars. Each is a single loop without branches, so
+// that the compiler can vectorize it. If any element is out of range, they
+// throw the error the single conversion would once the loop is done, leaving
+// the output unspecified.
+
+void gregorianToJdn(std::span<const Date> dates, std::span<CalcInt> jdns);
+void julianToJdn(std::span<const Date> dates, std::span<CalcInt> jdns);
+void revJulianToJdn(std::span<const Date> dates, std::span<CalcInt> jdns);
+
+void jdnToGregorian(std::span<const CalcInt> jdns, std::span<Date> dates);
+void jdnToJulian(std::span<const CalcInt> jdns, std::span<Date> dates);
+void jdnToRevJulian(std::span<const CalcInt> jdns, std::span<Date> dates);
+
+void gregorianToJulian(std::span<const Date> dates, std::span<Date> out);
+void julianToGregorian(std::span<const Date> dates, std::span<Date> out);
+void gregorianToRevJulian(std::span<const Date> dates, std::span<Date> out);
+void revJulianToGregorian(std::span<const Date> dates, std::span<Date> out);
+
+// The same, but rather than throwing, each stores the error of every element
+// in the element of errors with the same index, and returns the number of
+// elements in error. errors must be as large as the input and initialized: an
+// element that already holds an error keeps it, so that a span can be passed
+// through several stages and report the first error of each element. The
+// output of an element in error is unspecified.
+
+std::size_t tryGregorianToJdn(std::span<const Date> dates,
+                              std::span<CalcInt> jdns,
+                              std::span<EConversionError> errors);
+std::size_t tryJulianToJdn(std::span<const Date> dates,
+                           std::span<CalcInt> jdns,
+                           std::span<EConversionError> errors);
+std::size_t tryRevJulianToJdn(std::span<const Date> dates,
+                              std::span<CalcInt> jdns,
+                              std::span<EConversionError> errors);
+
+std::size_t tryJdnToRevJulian(std::span<const CalcInt> jdns,
+                              std::span<Date> dates,
+                              std::span<EConversionError> errors);
+
+std::size_t tryGregorianToJulian(std::span<const Date> dates,
+                                 std::span<Date> out,
+                                 std::span<EConversionError> errors);
+std::size_t tryJulianToGregorian(std::span<const Date> dates,
+                                 std::span<Date> out,
+                                 std::span<EConversionError> errors);
+std::size_t tryGregorianToRevJulian(std::span<const Date> dates,
+                                    std::span<Date> out,
+                                    std::span<EConversionError> errors);
+std::size_t tryRevJulianToGregorian(std::span<const Date> dates,
+                                    std::span<Date> out,
+                                    std::span<EConversionError> errors);
+
+// Calculate the number of days that the Gregorian calendar is ahead of the
+// Julian calendar from 1 March of the given year until the end of the
+// following February.
+constexpr CalcInt julianGregorianDrift(Year year)
+{
+  // Floor division, so that negative years are in the right century
+  return floorDiv(year, 100) - floorDiv(year, 400) - 2;
+} // julianGregorianDrift
 
 } // namespace pascha
 
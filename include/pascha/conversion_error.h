@@ -0,0 +1,98 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_CONVERSION_ERROR_H
+#define PASCHA_CONVERSION_ERROR_H
+
+#include <string_view>
+
+// The errors of dates out of the range of a calendar. The conversions and the
+// calculation methods report them as values, so that a batch can carry an
+// error for each element without unwinding, and so that the library can be
+// built without exceptions. Their throwing forms are wrappers that throw
+// std::overflow_error with the message of the error.
+
+namespace pascha
+{
+
+using EConversionError = int;
+
+namespace e_conversion_error
+{
+
+enum
+{
+  none = 0,
+  gregorian_year,  // the year is out of the range of the Gregorian calendar
+  julian_year,     // the year is out of the range of the Julian calendar
+  rev_julian_year, // the year is out of the range of the Revised Julian
+  rev_julian_jdn,  // the JDN is past the last Revised Julian date
+  last,            // for extensions
+};                 // enum
+
+} // namespace e_conversion_error
+
+// The message of an error, as thrown by the throwing functions.
+constexpr std::string_view conversionErrorMessage(EConversionError error)
+{
+  switch (error) {
+    case e_conversion_error::none: return {};
+    case e_conversion_error::gregorian_year:
+      return "Gregorian year out of range";
+    case e_conversion_error::julian_year: return "Julian year out of range";
+    case e_conversion_error::rev_julian_year:
+      return "Revised Julian year out of range";
+    case e_conversion_error::rev_julian_jdn:
+      return "JDN out of range to convert to Revised Julian";
+    default: return "Date out of range";
+  }
+} // conversionErrorMessage
+
+// Throw std::overflow_error with the message of the error. If the library is
+// built without exceptions, this aborts instead, so the throwing functions
+// should not be used for dates that may be out of range.
+[[noreturn]] void throwConversionError(EConversionError error);
+
+// A value, or the error that prevented it. Unlike Result, this holds no
+// message, so that it is cheap to return from every conversion and can be
+// used in constant expressions. The value of an error is unspecified.
+template <typename T>
+struct Checked
+{
+  T value;
+  EConversionError error{e_conversion_error::none};
+
+  constexpr bool ok() const { return error == e_conversion_error::none; }
+  constexpr explicit operator bool() const { return ok(); }
+
+  constexpr const T& operator*() const { return value; }
+  constexpr const T* operator->() const { return &value; }
+
+  // The value, throwing the error if there is one.
+  constexpr T valueOrThrow() const
+  {
+    if (!ok()) { throwConversionError(error); }
+    return value;
+  }
+}; // struct Checked
+
+} // namespace pascha
+
+#endif // !PASCHA_CONVERSION_ERROR_H
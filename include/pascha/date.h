@@ -31,18 +31,20 @@ struct Date
   Year year;
   Month month;
   Day day;
+
+  constexpr bool operator==(const Date&) const = default;
 }; // struct Date
 
 struct Weeks
 {
   std::int64_t value;
-  explicit Weeks(std::int64_t value) : value(value) {}
+  constexpr explicit Weeks(std::int64_t value) : value(value) {}
 }; // struct Weeks
 
 struct Days
 {
   std::int64_t value;
-  explicit Days(std::int64_t value) : value(value) {}
+  constexpr explicit Days(std::int64_t value) : value(value) {}
 }; // struct Days
 
 } // namespace pascha
@@ -0,0 +1,63 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+
+#ifndef PASCHA_GREGORIAN_TABLE_H
+#define PASCHA_GREGORIAN_TABLE_H
+
+#include "typedefs.h"
+
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+
+namespace pascha
+{
+
+// The Gregorian Paschalion repeats every 5,700,000 years, so a table of one
+// byte per year of the cycle holds the date of Pascha for every non-negative
+// year. The table is written to a file once and then mapped read-only by
+// MappedGregorianCalculationMethod, so that every process on a host shares
+// the same pages.
+//
+// The file starts with a 24 byte header of little-endian fields: the magic
+// "PASCHAGT", the format version, the length of the cycle, the FNV-1a checksum
+// of the table, and a reserved zero. The table follows, giving for each year
+// of the cycle the day of Pascha after 21 March (Gregorian).
+
+inline constexpr Year kGregorianCycle{5700000};
+inline constexpr std::uint32_t kGregorianTableVersion{1};
+inline constexpr std::size_t kGregorianTableHeaderSize{24};
+
+// Calculate the checksum of a table, as stored in the header.
+std::uint32_t gregorianTableChecksum(std::span<const std::uint8_t> table);
+
+// Write the complete table file, header and table, to the stream.
+void writeGregorianTable(std::ostream& out);
+
+// The path of the table file that is used when none is given. This is the
+// PASCHA_GREGORIAN_TABLE environment variable if set, otherwise the path it
+// is installed to.
+std::string defaultGregorianTablePath();
+
+} // namespace pascha
+
+#endif // !PASCHA_GREGORIAN_TABLE_H
@@ -21,9 +21,16 @@
 #ifndef PASCHA_I_CALCULATION_METHOD_H
 #define PASCHA_I_CALCULATION_METHOD_H
 
+#include "calendar_conversion.h"
+#include "conversion_error.h"
 #include "date.h"
 #include "typedefs.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+
 namespace pascha
 {
 
@@ -31,7 +38,68 @@ class ICalculationMethod
 {
  public:
   virtual ~ICalculationMethod() = default;
-  virtual Date calculate(Year) const = 0;
+  // Calculate the date, or the error of a year whose date is out of the range
+  // of a calendar it passes through.
+  virtual Checked<Date> tryCalculate(Year) const = 0;
+  // Calculate the Julian Day Number of the day that tryCalculate gives,
+  // whatever calendar it is output in. This is how the stages of a
+  // calculation pass the date between them, so that a Date is only made at
+  // the output. The default is for methods giving a Gregorian date.
+  virtual Checked<CalcInt> tryCalculateJdn(Year year) const
+  {
+    Checked<Date> date{tryCalculate(year)};
+    if (!date) { return {0, date.error}; }
+    return tryGregorianToJdn(*date);
+  }
+  // Calculate the date for each of the given years, storing it in the element
+  // of dates with the same index, and the error of each year in error in the
+  // element of errors. dates and errors must be at least as large as years,
+  // and errors initialized with e_conversion_error::none. Returns the number
+  // of years in error, whose dates are unspecified. Implementations should
+  // override this to handle the whole span in one loop, rather than one
+  // virtual call per year.
+  virtual std::size_t tryCalculate(std::span<const Year> years,
+                                   std::span<Date> dates,
+                                   std::span<EConversionError> errors) const
+  {
+    std::size_t count{0};
+    for (std::size_t i{0}; i < years.size(); ++i) {
+      Checked<Date> date{tryCalculate(years[i])};
+      dates[i] = date.value;
+      errors[i] = date.error;
+      count += !date.ok();
+    }
+    return count;
+  }
+
+  // The same, throwing the error as std::overflow_error rather than returning
+  // it. The batch calculate throws the error of the first year in error,
+  // leaving dates unspecified.
+  Date calculate(Year year) const { return tryCalculate(year).valueOrThrow(); }
+  CalcInt calculateJdn(Year year) const
+  {
+    return tryCalculateJdn(year).valueOrThrow();
+  }
+  void calculate(std::span<const Year> years, std::span<Date> dates) const
+  {
+    // Calculate in blocks, so that the errors are held on the stack.
+    constexpr std::size_t kBlockSize{1024};
+    std::array<EConversionError, kBlockSize> errors;
+    for (std::size_t first{0}; first < years.size(); first += kBlockSize) {
+      std::size_t size{std::min(kBlockSize, years.size() - first)};
+      std::span<EConversionError> block_errors{errors.data(), size};
+      std::fill(block_errors.begin(), block_errors.end(),
+                e_conversion_error::none);
+      if (tryCalculate(years.subspan(first, size), dates.subspan(first),
+                       block_errors) != 0) {
+        throwConversionError(*std::find_if(
+            block_errors.begin(), block_errors.end(),
+            [](EConversionError error) {
+              return error != e_conversion_error::none;
+            }));
+      }
+    }
+  }
 }; // class ICalculationMethod
 
 } // namespace pascha
@@ -21,12 +21,15 @@
 #ifndef PASCHA_I_CALCULATOR_MODEL_H
 #define PASCHA_I_CALCULATOR_MODEL_H
 
+#include "calculation_options.h"
 #include "i_calculation_method.h"
 #include "i_observable.h"
+#include "result.h"
 #include "typedefs.h"
 
 #include <iostream>
 #include <memory>
+#include <span>
 
 namespace pascha
 {
@@ -35,15 +38,30 @@ class ICalculatorModel : public IObservable
 {
  public:
   virtual ~ICalculatorModel() = default;
-  virtual void setCalculationMethod(std::unique_ptr<ICalculationMethod>) = 0;
+  virtual void setCalculationMethod(std::shared_ptr<ICalculationMethod>) = 0;
+  // Set the calculation method with the target output that it calculates, as
+  // given to observers with each block of dates. Otherwise it is Pascha.
+  virtual void setCalculationMethod(std::shared_ptr<ICalculationMethod>,
+                                    ETargetOutput) = 0;
   virtual void calculate(Year) const = 0;
+  // Calculate the date for each of the given years in one pass through the
+  // calculation method, notifying the dates in order.
+  virtual void calculate(std::span<const Year>) const = 0;
   // Calculate the number of days until Pascha in the given year.
   virtual void daysUntil(Year) const = 0;
   // Calculate the number of days between the dates calculated by the two
   // methods, for the given year. Typically this will be between the Julian and
   // Gregorian methods for calculating Pascha.
-  virtual void weeksBetween(Year, std::unique_ptr<ICalculationMethod>,
-                            std::unique_ptr<ICalculationMethod>) const = 0;
+  virtual void weeksBetween(Year, std::shared_ptr<ICalculationMethod>,
+                            std::shared_ptr<ICalculationMethod>) const = 0;
+
+  // The same calculations, returning the result instead of notifying it, so
+  // that it can be used without being printed.
+  virtual Result<Date> calculateDate(Year) const = 0;
+  virtual Result<Days> calculateDaysUntil(Year) const = 0;
+  virtual Result<Weeks>
+      calculateWeeksBetween(Year, std::shared_ptr<ICalculationMethod>,
+                            std::shared_ptr<ICalculationMethod>) const = 0;
 }; // class ICalculatorModel
 
 } // namespace pascha
@@ -21,6 +21,7 @@
 #ifndef PASCHA_I_OBSERVABLE_H
 #define PASCHA_I_OBSERVABLE_H
 
+#include <span>
 #include <string_view>
 
 #include "date.h"
@@ -43,6 +44,9 @@ class IObservable
   virtual void notify(Days) const = 0;
   // Used to notify string messages, such as errors.
   virtual void notify(std::string_view) const = 0;
+  // Used to notify a block of date outputs at once, with what each was
+  // calculated for.
+  virtual void notify(std::span<const Date>, const DatesMetadata&) const = 0;
 }; // class IObservable
 
 } // namespace pascha
@@ -21,13 +21,24 @@
 #ifndef PASCHA_I_OBSERVER_H
 #define PASCHA_I_OBSERVER_H
 
+#include "calculation_options.h"
 #include "date.h"
 
+#include <span>
 #include <string_view>
 
 namespace pascha
 {
 
+// What a block of dates was calculated for, item by item.
+struct DatesMetadata
+{
+  // The year each date was calculated for, which is not the year of the date
+  // when it is given as a Byzantine year.
+  std::span<const Year> years;
+  ETargetOutput target;
+}; // struct DatesMetadata
+
 class IObserver
 {
  public:
@@ -40,6 +51,12 @@ class IObserver
   virtual void update(Days) = 0;
   // Used to receive string messages, such as errors.
   virtual void update(std::string_view) = 0;
+  // Used to receive a block of date outputs at once, so that they can be
+  // handled in one pass. By default each is received as a single date.
+  virtual void update(std::span<const Date> dates, const DatesMetadata&)
+  {
+    for (const Date& date : dates) { update(date); }
+  }
 }; // class IObserver
 
 } // namespace pascha
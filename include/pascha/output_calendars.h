@@ -32,7 +32,10 @@ class JulianOutputCalendar : public OutputCalendar
   JulianOutputCalendar(std::shared_ptr<ICalculationMethod> calculation_method)
     : OutputCalendar{calculation_method} {}
   ~JulianOutputCalendar() = default;
-  Date calculate(Year) const override;
+  Checked<Date> tryCalculate(Year) const override;
+  Checked<CalcInt> tryCalculateJdn(Year) const override;
+  std::size_t tryCalculate(std::span<const Year>, std::span<Date>,
+                           std::span<EConversionError>) const override;
 }; // class JulianOutputCalendar
 
 class GregorianOutputCalendar : public OutputCalendar
@@ -41,7 +44,10 @@ class GregorianOutputCalendar : public OutputCalendar
   GregorianOutputCalendar(std::shared_ptr<ICalculationMethod> calculation_method)
     : OutputCalendar{calculation_method} {}
   ~GregorianOutputCalendar() = default;
-  Date calculate(Year) const override;
+  Checked<Date> tryCalculate(Year) const override;
+  Checked<CalcInt> tryCalculateJdn(Year) const override;
+  std::size_t tryCalculate(std::span<const Year>, std::span<Date>,
+                           std::span<EConversionError>) const override;
 }; // class GregorianOutputCalendar
 
 class RevisedJulianOutputCalendar : public OutputCalendar
@@ -50,7 +56,10 @@ class RevisedJulianOutputCalendar : public OutputCalendar
   RevisedJulianOutputCalendar(std::shared_ptr<ICalculationMethod> calculation_method)
     : OutputCalendar{calculation_method} {}
   ~RevisedJulianOutputCalendar() = default;
-  Date calculate(Year) const override;
+  Checked<Date> tryCalculate(Year) const override;
+  Checked<CalcInt> tryCalculateJdn(Year) const override;
+  std::size_t tryCalculate(std::span<const Year>, std::span<Date>,
+                           std::span<EConversionError>) const override;
 }; // class RevisedJulianOutputCalendar
 
 } // namespace pascha
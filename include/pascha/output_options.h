@@ -32,7 +32,10 @@ class ByzantineDate : public OutputOption
   ByzantineDate(std::shared_ptr<ICalculationMethod> calculation_method)
     : OutputOption{calculation_method} {}
   ~ByzantineDate() = default;
-  Date calculate(Year) const override;
+  Checked<Date> tryCalculate(Year) const override;
+  Checked<CalcInt> tryCalculateJdn(Year) const override;
+  std::size_t tryCalculate(std::span<const Year>, std::span<Date>,
+                           std::span<EConversionError>) const override;
 }; // class ByzantineDate
 
 } // namespace pascha
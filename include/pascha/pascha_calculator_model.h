@@ -39,20 +39,31 @@ class PaschaCalculatorModel : public ICalculatorModel
   virtual ~PaschaCalculatorModel() = default;
 
   virtual void
-      setCalculationMethod(std::unique_ptr<ICalculationMethod>) override;
+      setCalculationMethod(std::shared_ptr<ICalculationMethod>) override;
+  virtual void setCalculationMethod(std::shared_ptr<ICalculationMethod>,
+                                    ETargetOutput) override;
   virtual void calculate(Year) const override;
+  virtual void calculate(std::span<const Year>) const override;
   virtual void daysUntil(Year) const override;
-  virtual void weeksBetween(Year, std::unique_ptr<ICalculationMethod>,
-                            std::unique_ptr<ICalculationMethod>) const override;
+  virtual void weeksBetween(Year, std::shared_ptr<ICalculationMethod>,
+                            std::shared_ptr<ICalculationMethod>) const override;
+  virtual Result<Date> calculateDate(Year) const override;
+  virtual Result<Days> calculateDaysUntil(Year) const override;
+  virtual Result<Weeks>
+      calculateWeeksBetween(Year, std::shared_ptr<ICalculationMethod>,
+                            std::shared_ptr<ICalculationMethod>) const override;
   virtual void addObserver(IObserver&) override;
   virtual void removeObserver(IObserver&) override;
   virtual void notify(const Date&) const override;
   virtual void notify(Weeks) const override;
   virtual void notify(Days) const override;
   virtual void notify(std::string_view) const override;
+  virtual void notify(std::span<const Date>,
+                      const DatesMetadata&) const override;
 
  private:
-  std::unique_ptr<ICalculationMethod> m_calculation_method{nullptr};
+  std::shared_ptr<ICalculationMethod> m_calculation_method{nullptr};
+  ETargetOutput m_target_output{e_target_output::pascha};
   std::vector<IObserver*> m_observers{};
 }; // class PaschaCalculatorModel
 
@@ -0,0 +1,121 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_PASCHA_INDEX_H
+#define PASCHA_PASCHA_INDEX_H
+
+#include "calculation_options.h"
+#include "date.h"
+#include "i_calculation_method.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace pascha
+{
+
+// The years of the cycle of a computus by their date of Pascha, which are
+// shared by every index of the same method. Defined in pascha_index.cpp.
+struct PaschaCycle;
+
+// How often Pascha falls on each date over a span of years, as counted by
+// PaschaIndex::statistics.
+struct PaschaStatistics
+{
+  // A month and day that Pascha falls on, with the number of years in which it
+  // does and the first of them.
+  struct DateCount
+  {
+    Month month;
+    Day day;
+    std::uint64_t years;
+    Year first;
+  }; // struct DateCount
+
+  // The number of years that could be calculated.
+  std::uint64_t years{0};
+  // The dates in the order of the year from 1 March, including the 30 and 31
+  // February that the Gregorian computus gives for some negative years.
+  std::vector<DateCount> dates{};
+  // The first years with the earliest and the latest Pascha, by the days after
+  // 1 March of their year, if any years could be calculated.
+  Year earliest{};
+  Year latest{};
+}; // struct PaschaStatistics
+
+// An inverted index of the dates of Pascha, which finds the years whose Pascha
+// falls on a given month and day without calculating every year in between.
+//
+// The date of Pascha by each computus repeats in a cycle, of 532 years for the
+// Julian and 5,700,000 years for the Gregorian, so the years with Pascha on a
+// date are arithmetic progressions whose starts are the years of the cycle
+// with that date. In another output calendar, the date is moved by the drift
+// between the calendars, which only changes at the turn of a century, and the
+// centuries in which the drift can not bring Pascha to the date are skipped.
+// The time taken is proportional to the number of years found, however long
+// the span they are found in.
+class PaschaIndex
+{
+ public:
+  PaschaIndex(ECalculationMethod calculation_method,
+              EOutputCalendar output_calendar);
+
+  // Call visit with each year from `from` to `to` whose date of Pascha in the
+  // output calendar falls on month and day, in increasing order. The years are
+  // those that ICalculationMethod::calculate gives the date for, excluding any
+  // before kGregorianMinYear, which can only be if hasEarlierYears() is true.
+  void forEachYear(Month month, Day day, Year from, Year to,
+                   const std::function<void(Year)>& visit) const;
+  std::vector<Year> findYears(Month month, Day day, Year from, Year to) const;
+  // Count the years from `from` to `to` by their date of Pascha. In the
+  // calendar of the computus the whole cycles of the span are counted at
+  // once, and in another calendar the whole cycles between the first and the
+  // last cycle of the span, which are calculated year by year.
+  PaschaStatistics statistics(Year from, Year to) const;
+  // The years that can be found are from kGregorianMinYear to this year.
+  Year lastYear() const { return m_last_year; }
+  // Whether the years before kGregorianMinYear have a date of Pascha, which
+  // can not be found or counted, as the Gregorian computus alone gives them.
+  bool hasEarlierYears() const { return m_earlier_years; }
+
+ private:
+  EOutputCalendar m_output_calendar;
+  std::shared_ptr<ICalculationMethod> m_pascha;
+  const PaschaCycle& m_cycle;
+  // The last year whose date of Pascha can be calculated.
+  Year m_last_year{};
+  // Whether the year before kGregorianMinYear can be calculated.
+  bool m_earlier_years{};
+  // The dates of Pascha of the negative years from kGregorianMinYear, which
+  // do not follow the cycle, as the computus uses truncating remainders. The
+  // month is 0 for a date that can not be calculated.
+  std::vector<Date> m_negative_years{};
+
+  // Search years from 0 in an output calendar other than that of the
+  // computus, century by century.
+  void forEachDriftedYear(Month month, Day day, Year from, Year to,
+                          const std::function<void(Year)>& visit) const;
+}; // class PaschaIndex
+
+} // namespace pascha
+
+#endif // !PASCHA_PASCHA_INDEX_H
@@ -0,0 +1,89 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_RESULT_H
+#define PASCHA_RESULT_H
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace pascha
+{
+
+using ECalculationError = int;
+
+namespace e_calculation_error
+{
+
+enum
+{
+  none = 0,
+  no_method,    // no calculation method was set
+  out_of_range, // the year or date is out of the range of a calendar
+  last,         // for extensions
+};              // enum
+
+} // namespace e_calculation_error
+
+// The value of a calculation, or the error that stopped it, with the message
+// that would otherwise be notified to the observers.
+template <typename T>
+class Result
+{
+ public:
+  Result(T value) : m_result{std::move(value)} {}
+  Result(ECalculationError error, std::string_view message)
+      : m_result{Error{error, std::string{message}}}
+  {
+  }
+
+  bool ok() const { return std::holds_alternative<T>(m_result); }
+  explicit operator bool() const { return ok(); }
+
+  // Only valid when ok().
+  const T& value() const { return std::get<T>(m_result); }
+  const T& operator*() const { return value(); }
+  const T* operator->() const { return &value(); }
+
+  ECalculationError error() const
+  {
+    return ok() ? e_calculation_error::none
+                : std::get<Error>(m_result).error;
+  }
+  std::string_view message() const
+  {
+    return ok() ? std::string_view{} : std::get<Error>(m_result).message;
+  }
+
+ private:
+  struct Error
+  {
+    ECalculationError error;
+    std::string message;
+  }; // struct Error
+
+  std::variant<T, Error> m_result;
+}; // class Result
+
+} // namespace pascha
+
+#endif // !PASCHA_RESULT_H
@@ -0,0 +1,218 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+
+#ifndef PASCHA_STATIC_PIPELINE_H
+#define PASCHA_STATIC_PIPELINE_H
+
+#include "calculation_methods.h"
+#include "calculation_options.h"
+#include "calendar_conversion.h"
+#include "computus.h"
+#include "i_calculation_method.h"
+
+#include <memory>
+#include <type_traits>
+
+namespace pascha
+{
+
+// The stages of a StaticPipeline. Each computus gives the date of Pascha in
+// the Gregorian calendar, as the calculation methods do, or its Julian Day
+// Number, and each calendar makes the date for output from a JDN. As with the
+// output calendars, which convert from the Gregorian calendar, a JDN outside
+// of its range is an error for the Julian and Revised Julian calendars.
+namespace pipeline
+{
+
+struct JulianComputus
+{
+  using Method = JulianCalculationMethod;
+  static constexpr Checked<Date> pascha(Year year)
+  {
+    return tryJulianToGregorian(julianPascha(year));
+  }
+  static constexpr Checked<CalcInt> paschaJdn(Year year)
+  {
+    return tryJulianToJdn(julianPascha(year));
+  }
+}; // struct JulianComputus
+
+struct GregorianComputus
+{
+  using Method = GregorianCalculationMethod;
+  static constexpr Checked<Date> pascha(Year year)
+  {
+    return {gregorianPascha(year)};
+  }
+  static constexpr Checked<CalcInt> paschaJdn(Year year)
+  {
+    return tryGregorianToJdn(gregorianPascha(year));
+  }
+}; // struct GregorianComputus
+
+struct JulianCalendar
+{
+  static constexpr Checked<Date> output(CalcInt jdn)
+  {
+    Checked<CalcInt> checked{tryCheckGregorianJdn(jdn)};
+    if (!checked) { return {{}, checked.error}; }
+    return {jdnToJulian(jdn)};
+  }
+}; // struct JulianCalendar
+
+struct GregorianCalendar
+{
+  static constexpr Checked<Date> output(CalcInt jdn)
+  {
+    return {jdnToGregorian(jdn)};
+  }
+}; // struct GregorianCalendar
+
+struct RevisedJulianCalendar
+{
+  static constexpr Checked<Date> output(CalcInt jdn)
+  {
+    Checked<CalcInt> checked{tryCheckGregorianJdn(jdn)};
+    if (!checked) { return {{}, checked.error}; }
+    return tryJdnToRevJulian(jdn);
+  }
+}; // struct RevisedJulianCalendar
+
+} // namespace pipeline
+
+// The same as a calculation method wrapped in a TargetDate, an OutputCalendar
+// and optionally a ByzantineDate, but composed at compile time, so that the
+// whole chain is one call which the compiler can inline. Shift is the number
+// of days from Pascha to the target date. Between the stages the date is
+// carried as a JDN, and it is only made into a Date in the output calendar.
+template <typename Computus, int Shift, typename Calendar, bool Byzantine>
+class StaticPipeline final : public ICalculationMethod
+{
+ public:
+  ~StaticPipeline() = default;
+
+  Checked<Date> tryCalculate(Year year) const override
+  {
+    if constexpr (kPascha) {
+      return byzantine(Computus::pascha(year));
+    } else {
+      Checked<CalcInt> jdn{Computus::paschaJdn(year)};
+      if (!jdn) { return {{}, jdn.error}; }
+      return output(*jdn);
+    }
+  }
+
+  Checked<CalcInt> tryCalculateJdn(Year year) const override
+  {
+    Checked<CalcInt> jdn{Computus::paschaJdn(year)};
+    if (jdn) { jdn = tryCheckGregorianJdn(*jdn); }
+    if constexpr (Shift != 0) {
+      if (jdn) { jdn = tryCheckGregorianJdn(*jdn + Shift); }
+    }
+    return jdn;
+  }
+
+  std::size_t tryCalculate(std::span<const Year> years, std::span<Date> dates,
+                           std::span<EConversionError> errors) const override
+  {
+    // The vector kernels of the calculation method, called without virtual
+    // dispatch, followed by the rest of the pipeline in one loop.
+    m_method.Method::tryCalculate(years, dates, errors);
+    std::size_t count{0};
+    for (std::size_t i{0}; i < years.size(); ++i) {
+      Checked<Date> date{tryFinish(dates[i])};
+      dates[i] = date.value;
+      errors[i] =
+          errors[i] != e_conversion_error::none ? errors[i] : date.error;
+      count += errors[i] != e_conversion_error::none;
+    }
+    return count;
+  }
+
+  // Apply every stage after the computus to the date of Pascha in the
+  // Gregorian calendar.
+  static constexpr Checked<Date> tryFinish(Date pascha)
+  {
+    if constexpr (kPascha) {
+      return byzantine({pascha});
+    } else {
+      Checked<CalcInt> jdn{tryGregorianToJdn(pascha)};
+      if (!jdn) { return {{}, jdn.error}; }
+      return output(*jdn);
+    }
+  }
+
+  static constexpr Date finish(Date pascha)
+  {
+    return tryFinish(pascha).valueOrThrow();
+  }
+
+ private:
+  using Method = typename Computus::Method;
+  // Whether the date of Pascha from the computus is output as it is.
+  static constexpr bool kPascha{
+      Shift == 0 && std::is_same_v<Calendar, pipeline::GregorianCalendar>};
+
+  Method m_method{};
+
+  // Make the output date from the JDN of Pascha.
+  static constexpr Checked<Date> output(CalcInt jdn)
+  {
+    if constexpr (Shift != 0) {
+      Checked<CalcInt> checked{tryCheckGregorianJdn(jdn)};
+      if (!checked) { return {{}, checked.error}; }
+      jdn += Shift;
+    }
+    return byzantine(Calendar::output(jdn));
+  }
+
+  static constexpr Checked<Date> byzantine(Checked<Date> date)
+  {
+    if constexpr (Byzantine) {
+      date.value.year += 5508;
+      if (date.value.month > 8) { ++date.value.year; }
+    }
+    return date;
+  }
+}; // class StaticPipeline
+
+// The stages of a pipeline after the computus, to derive its date from the
+// date of Pascha in the Gregorian calendar, or the error of a date out of
+// range.
+using PipelineFinish = Checked<Date> (*)(Date);
+
+// Make the pipeline for the given options, which is chosen from a table of
+// every combination instantiated at compile time. As in the controller, an
+// unknown method or calendar is taken to be Julian. Returns nullptr for a
+// target output that is not a date, such as days until.
+std::shared_ptr<ICalculationMethod> makeStaticPipeline(ECalculationMethod,
+                                                       ETargetOutput,
+                                                       EOutputCalendar,
+                                                       bool byzantine);
+// The finish of the pipeline for the given options, which is the same for
+// either calculation method. Returns nullptr for a target output that is not
+// a date.
+PipelineFinish staticPipelineFinish(ETargetOutput, EOutputCalendar,
+                                    bool byzantine);
+
+} // namespace pascha
+
+#endif // !PASCHA_STATIC_PIPELINE_H
@@ -36,11 +36,13 @@ class TargetDate : public CalculationMethodDecorator
   TargetDate(std::shared_ptr<ICalculationMethod> calculation_method, int shift_amount)
     : CalculationMethodDecorator{calculation_method}, m_shift_amount{shift_amount} {}
   virtual ~TargetDate() = default;
-  Date calculate(Year) const override;
+  Checked<Date> tryCalculate(Year) const override;
+  Checked<CalcInt> tryCalculateJdn(Year) const override;
+  std::size_t tryCalculate(std::span<const Year>, std::span<Date>,
+                           std::span<EConversionError>) const override;
 
  private:
   int m_shift_amount{};
-  void shift(int, Date&) const;
 }; // class TargetDate
 
 } // namespace pascha
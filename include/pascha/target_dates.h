@@ -26,11 +26,20 @@
 namespace pascha
 {
 
+// The number of days from Pascha to each target date.
+inline constexpr int kMeatfareShift{-56};
+inline constexpr int kCheesefareShift{-49};
+inline constexpr int kAshWednesdayShift{-46};
+inline constexpr int kMidfeastPentecostShift{24};
+inline constexpr int kLeavetakingPaschaShift{38};
+inline constexpr int kAscensionShift{39};
+inline constexpr int kPentecostShift{49};
+
 class Meatfare : public TargetDate
 {
  public:
   Meatfare(std::shared_ptr<ICalculationMethod> calculation_method)
-    : TargetDate{calculation_method, -56} {}
+    : TargetDate{calculation_method, kMeatfareShift} {}
   ~Meatfare() = default;
 }; // class Meatfare
 
@@ -38,7 +47,7 @@ class Cheesefare : public TargetDate
 {
  public:
   Cheesefare(std::shared_ptr<ICalculationMethod> calculation_method)
-    : TargetDate{calculation_method, -49} {}
+    : TargetDate{calculation_method, kCheesefareShift} {}
   ~Cheesefare() = default;
 }; // class Cheesefare
 
@@ -46,7 +55,7 @@ class AshWednesday : public TargetDate
 {
  public:
   AshWednesday(std::shared_ptr<ICalculationMethod> calculation_method)
-    : TargetDate{calculation_method, -46} {}
+    : TargetDate{calculation_method, kAshWednesdayShift} {}
   ~AshWednesday() = default;
 }; // class AshWednesday
 
@@ -54,7 +63,7 @@ class MidfeastPentecost : public TargetDate
 {
  public:
   MidfeastPentecost(std::shared_ptr<ICalculationMethod> calculation_method)
-    : TargetDate{calculation_method, 24} {}
+    : TargetDate{calculation_method, kMidfeastPentecostShift} {}
   ~MidfeastPentecost() = default;
 }; // class MidfeastPentecost
 
@@ -62,7 +71,7 @@ class LeavetakingPascha : public TargetDate
 {
  public:
   LeavetakingPascha(std::shared_ptr<ICalculationMethod> calculation_method)
-    : TargetDate{calculation_method, 38} {}
+    : TargetDate{calculation_method, kLeavetakingPaschaShift} {}
   ~LeavetakingPascha() = default;
 }; // class LeavetakingPascha
 
@@ -70,7 +79,7 @@ class Ascension : public TargetDate
 {
  public:
   Ascension(std::shared_ptr<ICalculationMethod> calculation_method)
-    : TargetDate{calculation_method, 39} {}
+    : TargetDate{calculation_method, kAscensionShift} {}
   ~Ascension() = default;
 }; // class Ascension
 
@@ -78,7 +87,7 @@ class Pentecost : public TargetDate
 {
  public:
   Pentecost(std::shared_ptr<ICalculationMethod> calculation_method)
-    : TargetDate{calculation_method, 49} {}
+    : TargetDate{calculation_method, kPentecostShift} {}
   ~Pentecost() = default;
 }; // class Pentecost
 
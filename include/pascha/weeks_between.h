@@ -0,0 +1,94 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_WEEKS_BETWEEN_H
+#define PASCHA_WEEKS_BETWEEN_H
+
+#include "date.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace pascha
+{
+
+// Find the years in which Julian Pascha is a given number of weeks after
+// Gregorian Pascha, as ICalculatorModel::weeksBetween gives for the Julian
+// and Gregorian calculation methods: 0 weeks where the two coincide, and
+// usually 1, 4 or 5 where they diverge.
+//
+// The days between them in a year are the drift between the calendars plus
+// the difference of the days of each Pascha after 21 March, which are 1 to 35.
+// The drift never decreases from one year to the next, so a number of weeks
+// can only be found in the years where the drift is within 34 days of it, a
+// window of about 9,300 years. Only the years of that window are calculated,
+// however long the span searched is. The negative years, where the computus
+// does not keep to those days, are each calculated.
+
+// The weeks between the dates over a span of years, as calculated by
+// weeksBetweenStatistics.
+struct WeeksBetweenStatistics
+{
+  // A number of weeks between the dates, with the number of years that many
+  // weeks apart and the first of them, as given by forEachWeeksCount.
+  struct WeeksCount
+  {
+    Weeks weeks{0};
+    std::uint64_t years{0};
+    Year first{0};
+  }; // struct WeeksCount
+
+  // The number of years in which both dates could be calculated.
+  std::uint64_t years{0};
+  double mean{0};
+  Weeks least{0};
+  Weeks most{0};
+}; // struct WeeksBetweenStatistics
+
+// Call visit with each year from `from` to `to` that is `weeks` apart, in
+// increasing order. Years that can not be calculated are left out.
+void forEachWeeksBetween(Weeks weeks, Year from, Year to,
+                         const std::function<void(Year)>& visit);
+std::vector<Year> findWeeksBetween(Weeks weeks, Year from, Year to);
+std::uint64_t countWeeksBetween(Weeks weeks, Year from, Year to);
+
+// Find the mean, least and most weeks between the dates from `from` to `to`.
+// The mean is summed from the whole cycles of each computus and the drift,
+// and the least and most are in the windows at either end of the span, so no
+// more than those are calculated.
+WeeksBetweenStatistics weeksBetweenStatistics(Year from, Year to);
+
+// Call visit with the count of the years from `from` to `to` on each number of
+// weeks between the dates, in increasing order of the weeks, leaving out those
+// on which there are none. The weeks between the dates of a year are those of
+// the year a whole cycle of both computus before it, which is 39,900,000
+// years, plus the drift over the cycle, so those on which all the years of
+// the span fall are counted from one cycle, and only the years at either end
+// of the span are calculated. There are as many counts as there are weeks of
+// drift over the span, about one for every 930 years.
+void forEachWeeksCount(
+    Year from, Year to,
+    const std::function<void(const WeeksBetweenStatistics::WeeksCount&)>&
+        visit);
+
+} // namespace pascha
+
+#endif // !PASCHA_WEEKS_BETWEEN_H
@@ -20,42 +20,172 @@
 
 #include "pascha/calculation_methods.h"
 
+#include "computus_simd.h"
+#include "julian_paschalion.h"
 #include "pascha/calendar_conversion.h"
+#include "pascha/computus.h"
 #include "pascha/typedefs.h"
 
+#include <algorithm>
+#include <cstddef>
+
+// Helper functions for calculation
+namespace
+{
+using namespace pascha;
+
+// Whether every one of the simd::kLanes years starting at years is within the
+// range min to max.
+inline bool lanesWithin(const Year* years, Year min, Year max)
+{
+  return std::all_of(years, years + simd::kLanes,
+                     [=](Year year) { return year >= min && year <= max; });
+} // lanesWithin
+
+// Store the date of a year calculated on its own in a batch, with its error,
+// returning whether it is in error.
+inline std::size_t store(const Checked<Date>& date, Date& out,
+                         EConversionError& error)
+{
+  out = date.value;
+  error = date.error;
+  return !date.ok();
+} // store
+
+// Calculate the Gregorian date of Julian Pascha from the Julian Paschalion.
+inline Checked<Date> julianTablePascha(Year year)
+{
+  if (year > kJulianMaxYear || year < kJulianMinYear) {
+    return {{}, e_conversion_error::julian_year};
+  }
+
+  // Days of Pascha after 21 March in the Gregorian calendar
+  CalcInt days{paschalion::julianPaschaOffset(year) +
+               julianGregorianDrift(year)};
+
+  // Days after 1 March. Leap day only comes at the end of the year when
+  // counting from March, so within the year the month and day follow
+  // directly.
+  CalcInt day{days + 20};
+  if (day < 0 || day >= 365) {
+    return {jdnToGregorian(gregorianToJdn(Date{year, 3, 21}) + days)};
+  }
+
+  CalcInt month{(5 * day + 2) / 153};
+  day = day - (153 * month + 2) / 5 + 1;
+  month += 3;
+  if (month > 12) {
+    month -= 12;
+    ++year;
+  }
+  return {Date{year, static_cast<Month>(month), static_cast<Day>(day)}};
+} // julianTablePascha
+
+// Check the computus against known dates of Pascha when the library is built.
+static_assert(julianToGregorian(julianPascha(2024)) == Date{2024, 5, 5});
+static_assert(julianPascha(2024) == Date{2024, 4, 22});
+static_assert(julianToGregorian(julianPascha(1961)) == Date{1961, 4, 9});
+static_assert(gregorianPascha(2024) == Date{2024, 3, 31});
+static_assert(gregorianPascha(1961) == Date{1961, 4, 2});
+static_assert(gregorianPascha(2285) == Date{2285, 3, 22});
+static_assert(gregorianPascha(2038) == Date{2038, 4, 25});
+
+// Check the Julian Paschalion tables against the computus for the whole cycle
+// following a year, in both directions.
+constexpr bool julianTableMatches(Year from)
+{
+  for (Year year{from}; year < from + paschalion::kJulianCycle; ++year) {
+    if (julianToJdn(Date{year, 3, 21}) + paschalion::julianPaschaOffset(year) !=
+        julianToJdn(julianPascha(year))) {
+      return false;
+    }
+  }
+  return true;
+} // julianTableMatches
+
+static_assert(julianTableMatches(1492));
+static_assert(julianTableMatches(-1000));
+
+} // anonymous namespace
+
 namespace pascha
 {
 
-Date JulianCalculationMethod::calculate(Year year) const
-{
-  CalcInt a = year % 4;
-  CalcInt b = year % 7;
-  CalcInt c = year % 19;
-  CalcInt d = (19 * c + 15) % 30;
-  CalcInt e = (2 * a + 4 * b - d + 34) % 7;
-  CalcInt month = (d + e + 114) / 31;
-  CalcInt day = (d + e + 114) % 31 + 1;
-  return julianToGregorian(
-      Date{year, static_cast<Month>(month), static_cast<Day>(day)});
-} // JulianCalculationMethod::calculate
-
-Date GregorianCalculationMethod::calculate(Year year) const
-{
-  CalcInt a = year % 19;
-  CalcInt b = year / 100;
-  CalcInt c = year % 100;
-  CalcInt d = b / 4;
-  CalcInt e = b % 4;
-  CalcInt f = (b + 8) / 25;
-  CalcInt g = (b - f + 1) / 3;
-  CalcInt h = (19 * a + b - d - g + 15) % 30;
-  CalcInt i = c / 4;
-  CalcInt k = c % 4;
-  CalcInt l = (32 + 2 * e + 2 * i - h - k) % 7;
-  CalcInt m = (a + 11 * h + 22 * l) / 451;
-  CalcInt month = (h + l - 7 * m + 114) / 31;
-  CalcInt day = ((h + l - 7 * m + 114) % 31) + 1;
-  return Date{year, static_cast<Month>(month), static_cast<Day>(day)};
-} // GregorianCalculationMethod::calculate
+Checked<Date> JulianCalculationMethod::tryCalculate(Year year) const
+{
+  return tryJulianToGregorian(julianPascha(year));
+} // JulianCalculationMethod::tryCalculate
+
+Checked<CalcInt> JulianCalculationMethod::tryCalculateJdn(Year year) const
+{
+  Checked<CalcInt> jdn{tryJulianToJdn(julianPascha(year))};
+  if (!jdn) { return jdn; }
+  return tryCheckGregorianJdn(*jdn);
+} // JulianCalculationMethod::tryCalculateJdn
+
+std::size_t JulianCalculationMethod::tryCalculate(
+    std::span<const Year> years, std::span<Date> dates,
+    std::span<EConversionError> errors) const
+{
+  // Use the vector kernel for each group of years it can calculate exactly,
+  // and the scalar code for the rest, including any out of range years.
+  std::size_t count{0};
+  std::size_t i{0};
+  for (; i + simd::kLanes <= years.size(); i += simd::kLanes) {
+    if (lanesWithin(&years[i], simd::kJulianMinYear, simd::kJulianMaxYear)) {
+      simd::julianPascha(&years[i], &dates[i]);
+      continue;
+    }
+    for (std::size_t j{i}; j < i + simd::kLanes; ++j) {
+      count += store(tryCalculate(years[j]), dates[j], errors[j]);
+    }
+  }
+  for (; i < years.size(); ++i) {
+    count += store(tryCalculate(years[i]), dates[i], errors[i]);
+  }
+  return count;
+} // JulianCalculationMethod::tryCalculate
+
+Checked<Date> GregorianCalculationMethod::tryCalculate(Year year) const
+{
+  return {gregorianPascha(year)};
+} // GregorianCalculationMethod::tryCalculate
+
+std::size_t GregorianCalculationMethod::tryCalculate(
+    std::span<const Year> years, std::span<Date> dates,
+    std::span<EConversionError>) const
+{
+  // Use the vector kernel for each group of years it can calculate exactly,
+  // and the scalar code for the rest. The computus is defined for every year.
+  std::size_t i{0};
+  for (; i + simd::kLanes <= years.size(); i += simd::kLanes) {
+    if (lanesWithin(&years[i], simd::kGregorianMinYear,
+                    simd::kGregorianMaxYear)) {
+      simd::gregorianPascha(&years[i], &dates[i]);
+      continue;
+    }
+    for (std::size_t j{i}; j < i + simd::kLanes; ++j) {
+      dates[j] = gregorianPascha(years[j]);
+    }
+  }
+  for (; i < years.size(); ++i) { dates[i] = gregorianPascha(years[i]); }
+  return 0;
+} // GregorianCalculationMethod::tryCalculate
+
+Checked<Date> JulianTableCalculationMethod::tryCalculate(Year year) const
+{
+  return julianTablePascha(year);
+} // JulianTableCalculationMethod::tryCalculate
+
+std::size_t JulianTableCalculationMethod::tryCalculate(
+    std::span<const Year> years, std::span<Date> dates,
+    std::span<EConversionError> errors) const
+{
+  std::size_t count{0};
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    count += store(julianTablePascha(years[i]), dates[i], errors[i]);
+  }
+  return count;
+} // JulianTableCalculationMethod::tryCalculate
 
 } // namespace pascha
@@ -18,398 +18,354 @@
 // Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
 // reporting.
 
+
 #include "pascha/calendar_conversion.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
 #include <stdexcept>
+#include <string>
 
-// Helper functions for conversion
+// The conversions are defined constexpr in the header. Check them against
+// known dates when the library is built.
 namespace
 {
 using namespace pascha;
 
-// Overflow constants
-// These are only valid when CalcInt = std::int64_t
-constexpr CalcInt kGregorianMaxYear{25252734927761841};
-constexpr CalcInt kJulianMaxYear{25252216391110347};
-constexpr CalcInt kRevJulianMaxYear{25252754133231976};
-constexpr CalcInt kRevJulianMaxJdn{2305837553489651559};
-
-// To prevent invalid dates with Byzantine Calendar
-constexpr CalcInt kGregorianMinYear{-5508};
-constexpr CalcInt kJulianMinYear{-5508};
-constexpr CalcInt kRevJulianMinYear{-5508};
-
-// The following functions calculate the Julian Day Number (JDN) from a given
-// calendar date. This is used as a fixed point to convert between calendars.
+// The epoch of the Julian Day Number
+static_assert(julianToJdn(Date{-4712, 1, 1}) == 0);
+static_assert(gregorianToJdn(Date{-4713, 11, 24}) == 0);
+static_assert(jdnToJulian(0) == Date{-4712, 1, 1});
+static_assert(jdnToGregorian(0) == Date{-4713, 11, 24});
+
+// The J2000 epoch
+static_assert(gregorianToJdn(Date{2000, 1, 1}) == 2451545);
+static_assert(jdnToGregorian(2451545) == Date{2000, 1, 1});
+
+// The introduction of the Gregorian calendar
+static_assert(gregorianToJdn(Date{1582, 10, 15}) == 2299161);
+static_assert(julianToJdn(Date{1582, 10, 4}) == 2299160);
+static_assert(julianToGregorian(Date{1582, 10, 5}) == Date{1582, 10, 15});
+static_assert(gregorianToJulian(Date{1582, 10, 15}) == Date{1582, 10, 5});
+
+// The Julian and Gregorian calendars agree through the third century
+static_assert(julianToGregorian(Date{250, 3, 1}) == Date{250, 3, 1});
+static_assert(julianToGregorian(Date{-100, 3, 1}) == Date{-100, 2, 27});
+
+// The Revised Julian calendar agrees with the Gregorian until 28 February 2800
+static_assert(revJulianToJdn(Date{2024, 1, 1}) ==
+              gregorianToJdn(Date{2024, 1, 1}));
+static_assert(gregorianToRevJulian(Date{2800, 2, 28}) == Date{2800, 2, 28});
+static_assert(gregorianToRevJulian(Date{2800, 2, 29}) == Date{2800, 3, 1});
+static_assert(revJulianToGregorian(Date{1600, 3, 1}) == Date{1600, 3, 1});
+static_assert(jdnToRevJulian(2451545) == Date{2000, 1, 1});
+
+// The drift between the Julian and Gregorian calendars
+static_assert(julianGregorianDrift(2024) == 13);
+static_assert(julianGregorianDrift(250) == 0);
+static_assert(julianGregorianDrift(-100) == -2);
+static_assert(julianGregorianDrift(-101) == -3);
+static_assert(julianToGregorian(Date{-101, 3, 1}) == Date{-101, 2, 26});
+
+// Round trips at the limits of the supported years
+static_assert(gregorianToJulian(julianToGregorian(
+                  Date{kJulianMinYear, 3, 1})) == Date{kJulianMinYear, 3, 1});
+static_assert(julianToGregorian(Date{kJulianMaxYear, 12, 31}) ==
+              jdnToGregorian(julianToJdn(Date{kJulianMaxYear, 12, 31})));
+static_assert(revJulianToGregorian(gregorianToRevJulian(
+                  Date{kGregorianMinYear, 6, 1})) ==
+              Date{kGregorianMinYear, 6, 1});
 
-// gregorianToJdn is in the pascha namespace below.
+} // anonymous namespace
 
-CalcInt julianToJdn(const Date& date)
+namespace
 {
-  if (date.year > kJulianMaxYear || date.year < kJulianMinYear) {
-    throw std::overflow_error("Julian year out of range");
-  }
+using namespace pascha;
 
-  CalcInt y = date.year;
-  CalcInt m = date.month;
-  CalcInt jdn{};
-
-  // Calculate the number of 4 year cycles
-  CalcInt cycles{};
-  if (y < 0) {
-    cycles = y / 4 - 1;
-    if (y % 4 == 0) { ++cycles; }
-    y = (4 - (-1 * y % 4)) % 4;
-  } else {
-    cycles = y / 4;
-    y = y % 4;
-  }
+// Clamp the year of a date into the given range, recording whether it was
+// outside it. The batch conversions convert the clamped date, which keeps
+// their loops free of both branches and overflow, and report the error once
+// the loop is done if any date was out of range.
+constexpr Date clampYear(const Date& date, Year min, Year max,
+                         bool& out_of_range)
+{
+  out_of_range |= (date.year > max) | (date.year < min);
+  return Date{std::clamp(date.year, min, max), date.month, date.day};
+} // clampYear
 
-  // Treat months prior to leap day as if they were in the previous year
-  if (m < 3) {
-    m += 12;
-    --y;
-  }
+// Clamp a JDN to the largest that can be converted to the Revised Julian
+// calendar, recording whether it was larger.
+constexpr CalcInt clampRevJulianJdn(CalcInt jdn, bool& out_of_range)
+{
+  out_of_range |= jdn > kRevJulianMaxJdn;
+  return std::min(jdn, kRevJulianMaxJdn);
+} // clampRevJulianJdn
 
-  // Add contribution from number of leap years
-  if (y < 0 && y % 4 != 0) {
-    jdn = 365 * y + (y / 4 - 1);
-  } else {
-    jdn = 365 * y + (y / 4);
-  }
+void throwIf(bool out_of_range, EConversionError error)
+{
+  if (out_of_range) { throwConversionError(error); }
+} // throwIf
 
-  // Add contribution from number of months and current day in month
-  jdn = jdn + 153 * (m + 1) / 5 + date.day - 123;
+// Store the error of an element out of range, unless it already holds one,
+// and count the element if it is in error either way.
+constexpr void recordError(bool out_of_range, EConversionError error,
+                           EConversionError& slot, std::size_t& count)
+{
+  EConversionError found{out_of_range ? error : e_conversion_error::none};
+  slot = slot != e_conversion_error::none ? slot : found;
+  count += slot != e_conversion_error::none;
+} // recordError
 
-  // Add base contribution for days prior to 1/1/1
-  // and the total number of unaccounted cycles
-  jdn = jdn + 1721118 + 1461 * cycles;
+} // anonymous namespace
 
-  return jdn;
-} // julianToJdn
+namespace pascha
+{
 
-CalcInt revJulianToJdn(const Date& date)
+void throwConversionError(EConversionError error)
 {
-  if (date.year > kRevJulianMaxYear || date.year < kRevJulianMinYear) {
-    throw std::overflow_error("Revised Julian year out of range");
+#if defined(__cpp_exceptions)
+  throw std::overflow_error(std::string{conversionErrorMessage(error)});
+#else
+  static_cast<void>(error);
+  std::abort();
+#endif
+} // throwConversionError
+
+void gregorianToJdn(std::span<const Date> dates, std::span<CalcInt> jdns)
+{
+  bool out_of_range{false};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    jdns[i] = unchecked::gregorianToJdn(clampYear(
+        dates[i], kGregorianMinYear, kGregorianMaxYear, out_of_range));
   }
+  throwIf(out_of_range, e_conversion_error::gregorian_year);
+} // gregorianToJdn
 
-  CalcInt y = date.year;
-  CalcInt m = date.month;
-  CalcInt jdn{};
-
-  // Treat months prior to leap day as if they were in the previous year
-  if (m < 3) {
-    m += 12;
-    --y;
+void julianToJdn(std::span<const Date> dates, std::span<CalcInt> jdns)
+{
+  bool out_of_range{false};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    jdns[i] = unchecked::julianToJdn(
+        clampYear(dates[i], kJulianMinYear, kJulianMaxYear, out_of_range));
   }
+  throwIf(out_of_range, e_conversion_error::julian_year);
+} // julianToJdn
 
-  // Add contribution from number of leap years
-  if (y < 0 && y % 4 != 0) {
-    jdn = 365 * y + (y / 4 - 1);
-  } else {
-    jdn = 365 * y + (y / 4);
+void revJulianToJdn(std::span<const Date> dates, std::span<CalcInt> jdns)
+{
+  bool out_of_range{false};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    jdns[i] = unchecked::revJulianToJdn(clampYear(
+        dates[i], kRevJulianMinYear, kRevJulianMaxYear, out_of_range));
   }
-
-  // Skip leap years divisible by 100
-  CalcInt jdn1{y / 100};
-  if (y < 0 && y % 100 != 0) { --jdn1; }
-
-  // Retain leap year when 200 remainder after dividing by 900
-  CalcInt jdn2i{y + 300};
-  CalcInt jdn2{jdn2i / 900};
-  if (jdn2i < 0 && jdn2i % 900 != 0) { --jdn2; }
-
-  // Retain leap year when 600 remainder after dividing by 900
-  CalcInt jdn3i{y + 700};
-  CalcInt jdn3{jdn3i / 900};
-  if (jdn3i < 0 && jdn3i % 900 != 0) { --jdn3; }
-
-  // Add contribution from previous skipped and retained leap years
-  jdn = jdn - jdn1 + jdn2 + jdn3;
-
-  // Add contribution from number of months and current day in month
-  CalcInt jdn4i{153 * (m + 1)};
-  CalcInt jdn4{jdn4i / 5};
-  if (jdn4i < 0 && jdn4i % 5 != 0) { --jdn4; }
-  jdn = jdn + jdn4 + date.day - 123;
-
-  // Add base contribution for days prior to 1/1/1
-  jdn = jdn + 1721120;
-
-  return jdn;
+  throwIf(out_of_range, e_conversion_error::rev_julian_year);
 } // revJulianToJdn
 
-// The following functions calculate the calendar date from a given Julian Day
-// Number (JDN). They store it in the given Date reference
-
-void jdnToGregorian(CalcInt jdn, Date& date)
+void jdnToGregorian(std::span<const CalcInt> jdns, std::span<Date> dates)
 {
-  CalcInt year{};
-  CalcInt month{};
-  CalcInt day{};
-
-  // Remove contribution prior to 1/1/1
-  day = jdn - 1721120;
-
-  // Calculate the number of cycles of 400 years
-  // and remove their contribution
-  CalcInt cycles{};
-  if (day < 0) {
-    cycles = day / 146097 - 1;
-    if (day % 146097 == 0) { ++cycles; }
-    day = (146097 - (-1 * day % 146097)) % 146097;
-  } else {
-    cycles = day / 146097;
-    day = day % 146097;
-  }
-
-  // Adjusting removal of cycles due to rounding
-  CalcInt a{(4 * day + 3) / 146097};
-  day = day + a - a / 4;
-
-  // Calculating number of years contained in current day value
-  // and removing their contribution from day
-  year = (4 * day + 3) / 1461;
-  day = day - 1461 * year / 4;
-
-  // Calculating number of months contained in current day value
-  // and removing their contribution from day
-  month = (5 * day + 2) / 153;
-  day = day - (153 * month + 2) / 5;
-  ++day;
-
-  // Adjusting month and year values to have year start in january
-  // rather than divided pre- and post-leap day
-  month += 3;
-  if (month > 12) {
-    month -= 12;
-    ++year;
+  for (std::size_t i{0}; i < jdns.size(); ++i) {
+    dates[i] = jdnToGregorian(jdns[i]);
   }
-
-  // Adding contribution of 400 year cycles to the year
-  year = year + 400 * cycles;
-
-  // Setting output
-  date.year = year;
-  date.month = month;
-  date.day = day;
 } // jdnToGregorian
 
-void jdnToJulian(CalcInt jdn, Date& date)
+void jdnToJulian(std::span<const CalcInt> jdns, std::span<Date> dates)
 {
-  CalcInt year{};
-  CalcInt month{};
-  CalcInt day{};
-
-  // Remove contribution prior to 1/1/1
-  day = jdn - 1721118;
-
-  // Calculate the number of cycles of 4 years
-  // and remove their contribution
-  CalcInt cycles{};
-  if (day < 0) {
-    cycles = day / 1461 - 1;
-    if (day % 1461 == 0) { ++cycles; }
-    day = (1461 - (-1 * day % 1461)) % 1461;
-  } else {
-    cycles = day / 1461;
-    day = day % 1461;
-  }
-
-  // Calculating number of years contained in current day value
-  // and removing their contribution from day
-  year = (4 * day + 3) / 1461;
-  day = day - 1461 * year / 4;
-
-  // Calculating number of months contained in current day value
-  // and removing their contribution from day
-  month = (5 * day + 2) / 153;
-  day = day - (153 * month + 2) / 5;
-  ++day;
-
-  // Adjusting month and year values to have year start in january
-  // rather than divided pre- and post-leap day
-  month += 3;
-  if (month > 12) {
-    month -= 12;
-    ++year;
+  for (std::size_t i{0}; i < jdns.size(); ++i) {
+    dates[i] = jdnToJulian(jdns[i]);
   }
-
-  // Adding contribution of 4 year cycles to the year
-  year = year + 4 * cycles;
-
-  // Setting output
-  date.year = year;
-  date.month = month;
-  date.day = day;
 } // jdnToJulian
 
-void jdnToRevJulian(CalcInt jdn, Date& date)
+void jdnToRevJulian(std::span<const CalcInt> jdns, std::span<Date> dates)
 {
-  if (jdn > kRevJulianMaxJdn) {
-    throw std::overflow_error("JDN out of range to convert to Revised Julian");
+  bool out_of_range{false};
+  for (std::size_t i{0}; i < jdns.size(); ++i) {
+    dates[i] =
+        unchecked::jdnToRevJulian(clampRevJulianJdn(jdns[i], out_of_range));
   }
-
-  CalcInt year{};
-  CalcInt month{};
-  CalcInt day{};
-
-  // Remove contribution prior to 1/1/1
-  day = jdn - 1721120;
-
-  // Adjustments based on Revised Julian skipped leap years
-  // Base number of leap days
-  CalcInt ai{9 * day + 2};
-  CalcInt a{ai / 328718};
-  if (ai < 0 && ai % 328718 != 0) { --a; }
-
-  // Account for including years with remainder of 200 after division by 900
-  CalcInt a2{(a + 3) / 9};
-  if (a < -3 && a % 9 != -3) { --a2; }
-
-  // Account for including years with remainder of 600 after division by 900
-  CalcInt a3{(a + 7) / 9};
-  if (a < -7 && a % 9 != -7) { --a3; }
-  day = day + a - a2 - a3;
-
-  // Calculating number of years contained in current day value
-  // and removing their contribution from day
-  CalcInt yeari{4 * day + 3};
-  year = yeari / 1461;
-  if (yeari < 0 && yeari % 1461 != 0) { --year; }
-  CalcInt y{1461 * year / 4};
-  if (year < 0 && 1461 * year % 4 != 0) { --y; }
-  day = day - y;
-
-  // Calculating number of months contained in current day value
-  // and removing their contribution from day
-  CalcInt monthi{5 * day + 2};
-  month = monthi / 153;
-  if (monthi < 0 && monthi % 153 != 0) { --month; }
-  CalcInt day2i{153 * month + 2};
-  CalcInt day2{day2i / 5};
-  if (day2i < 0 && day2i % 5 != 0) { --day2; }
-  day = day - day2 + 1;
-
-  // Adjusting month and year values to have year start in january
-  // rather than divided pre- and post-leap day
-  month += 3;
-  if (month > 12) {
-    month -= 12;
-    ++year;
-  }
-
-  // Setting output
-  date.year = year;
-  date.month = month;
-  date.day = day;
+  throwIf(out_of_range, e_conversion_error::rev_julian_jdn);
 } // jdnToRevJulian
 
-} // anonymous namespace
-
-namespace pascha
+void gregorianToJulian(std::span<const Date> dates, std::span<Date> out)
 {
+  bool out_of_range{false};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    out[i] = jdnToJulian(unchecked::gregorianToJdn(clampYear(
+        dates[i], kGregorianMinYear, kGregorianMaxYear, out_of_range)));
+  }
+  throwIf(out_of_range, e_conversion_error::gregorian_year);
+} // gregorianToJulian
 
-// Calculate the Julian Day Number (JDN) from a given calendar date. This is
-// used as a fixed point to convert between calendars.
-CalcInt gregorianToJdn(const Date& date)
+void julianToGregorian(std::span<const Date> dates, std::span<Date> out)
 {
-  if (date.year > kGregorianMaxYear || date.year < kGregorianMinYear) {
-    throw std::overflow_error("Gregorian year out of range");
+  bool out_of_range{false};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    out[i] = jdnToGregorian(unchecked::julianToJdn(
+        clampYear(dates[i], kJulianMinYear, kJulianMaxYear, out_of_range)));
   }
+  throwIf(out_of_range, e_conversion_error::julian_year);
+} // julianToGregorian
 
-  CalcInt y = date.year;
-  CalcInt m = date.month;
-  CalcInt jdn{};
-
-  // Calculate the number of 400 year cycles
-  CalcInt cycles{};
-  if (y < 0) {
-    cycles = y / 400 - 1;
-    if (y % 400 == 0) { ++cycles; }
-    y = (400 - (-1 * y % 400)) % 400;
-  } else {
-    cycles = y / 400;
-    y = y % 400;
+void gregorianToRevJulian(std::span<const Date> dates, std::span<Date> out)
+{
+  // Either conversion can be out of range, so find the first element out of
+  // range of each to throw the error of whichever comes first.
+  std::size_t first_year_error{dates.size()};
+  std::size_t first_jdn_error{dates.size()};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    bool year_out_of_range{false};
+    bool jdn_out_of_range{false};
+    CalcInt jdn{unchecked::gregorianToJdn(clampYear(
+        dates[i], kGregorianMinYear, kGregorianMaxYear, year_out_of_range))};
+    out[i] =
+        unchecked::jdnToRevJulian(clampRevJulianJdn(jdn, jdn_out_of_range));
+    first_year_error =
+        std::min(first_year_error, year_out_of_range ? i : dates.size());
+    first_jdn_error =
+        std::min(first_jdn_error, jdn_out_of_range ? i : dates.size());
   }
+  throwIf(first_year_error <= first_jdn_error &&
+              first_year_error < dates.size(),
+          e_conversion_error::gregorian_year);
+  throwIf(first_jdn_error < dates.size(),
+          e_conversion_error::rev_julian_jdn);
+} // gregorianToRevJulian
 
-  // Treat months prior to leap day as if they were in the previous year
-  if (m < 3) {
-    m += 12;
-    --y;
+void revJulianToGregorian(std::span<const Date> dates, std::span<Date> out)
+{
+  bool out_of_range{false};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    out[i] = jdnToGregorian(unchecked::revJulianToJdn(clampYear(
+        dates[i], kRevJulianMinYear, kRevJulianMaxYear, out_of_range)));
   }
+  throwIf(out_of_range, e_conversion_error::rev_julian_year);
+} // revJulianToGregorian
 
-  // Add contribution from number of leap years
-  if (y < 0 && y % 4 != 0) {
-    jdn = 365 * y + (y / 4 - 1);
-  } else {
-    jdn = 365 * y + (y / 4);
+std::size_t tryGregorianToJdn(std::span<const Date> dates,
+                              std::span<CalcInt> jdns,
+                              std::span<EConversionError> errors)
+{
+  std::size_t count{0};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    bool out_of_range{false};
+    jdns[i] = unchecked::gregorianToJdn(clampYear(
+        dates[i], kGregorianMinYear, kGregorianMaxYear, out_of_range));
+    recordError(out_of_range, e_conversion_error::gregorian_year, errors[i],
+                count);
   }
+  return count;
+} // tryGregorianToJdn
 
-  // Add contribution from number of months and current day in month
-  jdn = jdn + 153 * (m + 1) / 5 + date.day - 123;
-
-  // Adjustments for leap year differences between Julian and Gregorian
-  // calendars (leap years skipped when divisible by 100 but not by 400)
-  // Adjustments when year is negative (casues off by one problem with modulo
-  // for leap year checks)
-  if (y < 0) {
-    if (y % 100 != 0) {
-      if (y % 400 != 0) {
-        jdn = jdn - (y / 100 - 1) + (y / 400 - 1);
-      } else {
-        jdn = jdn - (y / 100 - 1) + (y / 400);
-      }
-    } else {
-      if (y % 400 != 0) {
-        jdn = jdn - (y / 100) + (y / 400 - 1);
-      } else {
-        jdn = jdn - (y / 100) + (y / 400);
-      }
-    }
-  } else {
-    jdn = jdn - y / 100 + y / 400;
+std::size_t tryJulianToJdn(std::span<const Date> dates,
+                           std::span<CalcInt> jdns,
+                           std::span<EConversionError> errors)
+{
+  std::size_t count{0};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    bool out_of_range{false};
+    jdns[i] = unchecked::julianToJdn(
+        clampYear(dates[i], kJulianMinYear, kJulianMaxYear, out_of_range));
+    recordError(out_of_range, e_conversion_error::julian_year, errors[i],
+                count);
   }
+  return count;
+} // tryJulianToJdn
 
-  // Add base contribution for days prior to 1/1/1
-  // and the total number of unaccounted cycles
-  jdn = jdn + 1721120 + 146097 * cycles;
-
-  return jdn;
+std::size_t tryRevJulianToJdn(std::span<const Date> dates,
+                              std::span<CalcInt> jdns,
+                              std::span<EConversionError> errors)
+{
+  std::size_t count{0};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    bool out_of_range{false};
+    jdns[i] = unchecked::revJulianToJdn(clampYear(
+        dates[i], kRevJulianMinYear, kRevJulianMaxYear, out_of_range));
+    recordError(out_of_range, e_conversion_error::rev_julian_year, errors[i],
+                count);
+  }
+  return count;
+} // tryRevJulianToJdn
 
-} // gregorianToJdn
+std::size_t tryJdnToRevJulian(std::span<const CalcInt> jdns,
+                              std::span<Date> dates,
+                              std::span<EConversionError> errors)
+{
+  std::size_t count{0};
+  for (std::size_t i{0}; i < jdns.size(); ++i) {
+    bool out_of_range{false};
+    dates[i] =
+        unchecked::jdnToRevJulian(clampRevJulianJdn(jdns[i], out_of_range));
+    recordError(out_of_range, e_conversion_error::rev_julian_jdn, errors[i],
+                count);
+  }
+  return count;
+} // tryJdnToRevJulian
 
-Date gregorianToJulian(const Date& date)
+std::size_t tryGregorianToJulian(std::span<const Date> dates,
+                                 std::span<Date> out,
+                                 std::span<EConversionError> errors)
 {
-  Date julian_date{};
-  std::int64_t jdn = gregorianToJdn(date);
-  jdnToJulian(jdn, julian_date);
-  return julian_date;
-} // gregorianToJulian
+  std::size_t count{0};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    bool out_of_range{false};
+    out[i] = jdnToJulian(unchecked::gregorianToJdn(clampYear(
+        dates[i], kGregorianMinYear, kGregorianMaxYear, out_of_range)));
+    recordError(out_of_range, e_conversion_error::gregorian_year, errors[i],
+                count);
+  }
+  return count;
+} // tryGregorianToJulian
 
-Date julianToGregorian(const Date& date)
+std::size_t tryJulianToGregorian(std::span<const Date> dates,
+                                 std::span<Date> out,
+                                 std::span<EConversionError> errors)
 {
-  Date gregorian_date{};
-  std::int64_t jdn = julianToJdn(date);
-  jdnToGregorian(jdn, gregorian_date);
-  return gregorian_date;
-} // julianToGregorian
+  std::size_t count{0};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    bool out_of_range{false};
+    out[i] = jdnToGregorian(unchecked::julianToJdn(
+        clampYear(dates[i], kJulianMinYear, kJulianMaxYear, out_of_range)));
+    recordError(out_of_range, e_conversion_error::julian_year, errors[i],
+                count);
+  }
+  return count;
+} // tryJulianToGregorian
 
-Date gregorianToRevJulian(const Date& date)
+std::size_t tryGregorianToRevJulian(std::span<const Date> dates,
+                                    std::span<Date> out,
+                                    std::span<EConversionError> errors)
 {
-  Date rev_julian_date{};
-  std::int64_t jdn = gregorianToJdn(date);
-  jdnToRevJulian(jdn, rev_julian_date);
-  return rev_julian_date;
-} // gregorianToRevJulian
+  std::size_t count{0};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    bool year_out_of_range{false};
+    bool jdn_out_of_range{false};
+    CalcInt jdn{unchecked::gregorianToJdn(clampYear(
+        dates[i], kGregorianMinYear, kGregorianMaxYear, year_out_of_range))};
+    out[i] =
+        unchecked::jdnToRevJulian(clampRevJulianJdn(jdn, jdn_out_of_range));
+    // The year is checked first, as in the single conversion.
+    EConversionError error{year_out_of_range
+                               ? e_conversion_error::gregorian_year
+                               : e_conversion_error::rev_julian_jdn};
+    recordError(year_out_of_range || jdn_out_of_range, error, errors[i],
+                count);
+  }
+  return count;
+} // tryGregorianToRevJulian
 
-Date revJulianToGregorian(const Date& date)
+std::size_t tryRevJulianToGregorian(std::span<const Date> dates,
+                                    std::span<Date> out,
+                                    std::span<EConversionError> errors)
 {
-  Date gregorian_date{};
-  std::int64_t jdn = revJulianToJdn(date);
-  jdnToGregorian(jdn, gregorian_date);
-  return gregorian_date;
-} // revJulianToGregorian
+  std::size_t count{0};
+  for (std::size_t i{0}; i < dates.size(); ++i) {
+    bool out_of_range{false};
+    out[i] = jdnToGregorian(unchecked::revJulianToJdn(clampYear(
+        dates[i], kRevJulianMinYear, kRevJulianMaxYear, out_of_range)));
+    recordError(out_of_range, e_conversion_error::rev_julian_year, errors[i],
+                count);
+  }
+  return count;
+} // tryRevJulianToGregorian
 
 } // namespace pascha
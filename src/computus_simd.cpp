@@ -0,0 +1,189 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+
+#include "computus_simd.h"
+
+// Run time dispatch to the widest vector instructions the CPU supports. This
+// relies on ifunc support from the loader, so it is limited to x86-64 ELF
+// systems that have it.
+#if defined(__GNUC__) && defined(__x86_64__) &&                                \
+    (defined(__linux__) || defined(__FreeBSD__))
+#define PASCHA_TARGET_CLONES                                                   \
+  __attribute__((target_clones("avx2", "sse4.1", "default")))
+#else
+#define PASCHA_TARGET_CLONES
+#endif
+
+namespace
+{
+using namespace pascha;
+
+// Years added before converting to and from Julian Day Numbers, so that every
+// division is of a non-negative value. 5600 years is a whole number of both the
+// 4 year Julian and the 400 year Gregorian leap year cycles.
+constexpr std::int32_t kYearShift{5600};
+constexpr std::int32_t kJulianShiftDays{kYearShift / 4 * 1461};
+constexpr std::int32_t kGregorianShiftDays{kYearShift / 400 * 146097};
+
+// The following functions are written only with arithmetic operators, so that
+// they calculate either a single std::int32_t or a vector of them. They must
+// stay in step with the scalar code in computus.h and calendar_conversion.h.
+
+// Calculate the Gregorian date of Pascha by the Julian computus.
+template <typename Int>
+inline void julianPaschaLanes(const Int& year, Int& out_year,
+                              Int& out_month, Int& out_day)
+{
+  // Date of Pascha in the Julian calendar
+  Int a = year % 4;
+  Int b = year % 7;
+  Int c = year % 19;
+  Int d = (19 * c + 15) % 30;
+  Int e = (2 * a + 4 * b - d + 34) % 7;
+  Int month = (d + e + 114) / 31;
+  Int day = (d + e + 114) % 31 + 1;
+
+  // Julian Day Number of the Julian date. Treat months prior to leap day as if
+  // they were in the previous year, without branching. The computus only gives
+  // such months for negative years, where the remainders are negative.
+  Int early = (14 - month) / 12;
+  Int y = year + kYearShift - early;
+  month = month + 12 * early;
+  Int jdn = 365 * y + y / 4 + 153 * (month + 1) / 5 + day - 123 + 1721118 -
+            kJulianShiftDays;
+
+  // Gregorian date of the Julian Day Number
+  day = jdn - 1721120 + kGregorianShiftDays;
+  Int cycles = day / 146097;
+  day = day % 146097;
+  Int f = (4 * day + 3) / 146097;
+  day = day + f - f / 4;
+  y = (4 * day + 3) / 1461;
+  day = day - 1461 * y / 4;
+  month = (5 * day + 2) / 153;
+  day = day - (153 * month + 2) / 5 + 1;
+
+  // Move January and February into the next year without branching
+  month = month + 3;
+  Int carry = month / 13;
+  out_year = y + carry + 400 * cycles - kYearShift;
+  out_month = month - 12 * carry;
+  out_day = day;
+} // julianPaschaLanes
+
+// Calculate the Gregorian date of Pascha by the Gregorian computus.
+template <typename Int>
+inline void gregorianPaschaLanes(const Int& year, Int& out_month, Int& out_day)
+{
+  Int a = year % 19;
+  Int b = year / 100;
+  Int c = year % 100;
+  Int d = b / 4;
+  Int e = b % 4;
+  Int f = (b + 8) / 25;
+  Int g = (b - f + 1) / 3;
+  Int h = (19 * a + b - d - g + 15) % 30;
+  Int i = c / 4;
+  Int k = c % 4;
+  Int l = (32 + 2 * e + 2 * i - h - k) % 7;
+  Int m = (a + 11 * h + 22 * l) / 451;
+  out_month = (h + l - 7 * m + 114) / 31;
+  out_day = ((h + l - 7 * m + 114) % 31) + 1;
+} // gregorianPaschaLanes
+
+#if defined(__GNUC__)
+using Lanes = std::int32_t
+    __attribute__((vector_size(simd::kLanes * sizeof(std::int32_t))));
+#endif
+
+} // anonymous namespace
+
+namespace pascha::simd
+{
+
+#if defined(__GNUC__)
+
+PASCHA_TARGET_CLONES
+void julianPascha(const Year* years, Date* dates)
+{
+  Lanes year{};
+  for (std::size_t i{0}; i < kLanes; ++i) {
+    year[i] = static_cast<std::int32_t>(years[i]);
+  }
+
+  Lanes out_year{};
+  Lanes month{};
+  Lanes day{};
+  julianPaschaLanes(year, out_year, month, day);
+
+  for (std::size_t i{0}; i < kLanes; ++i) {
+    dates[i] = Date{out_year[i], static_cast<Month>(month[i]),
+                    static_cast<Day>(day[i])};
+  }
+} // julianPascha
+
+PASCHA_TARGET_CLONES
+void gregorianPascha(const Year* years, Date* dates)
+{
+  Lanes year{};
+  for (std::size_t i{0}; i < kLanes; ++i) {
+    year[i] = static_cast<std::int32_t>(years[i]);
+  }
+
+  Lanes month{};
+  Lanes day{};
+  gregorianPaschaLanes(year, month, day);
+
+  for (std::size_t i{0}; i < kLanes; ++i) {
+    dates[i] =
+        Date{years[i], static_cast<Month>(month[i]), static_cast<Day>(day[i])};
+  }
+} // gregorianPascha
+
+#else // Scalar fallback without vector extensions
+
+void julianPascha(const Year* years, Date* dates)
+{
+  for (std::size_t i{0}; i < kLanes; ++i) {
+    std::int32_t out_year{};
+    std::int32_t month{};
+    std::int32_t day{};
+    julianPaschaLanes(static_cast<std::int32_t>(years[i]), out_year, month,
+                      day);
+    dates[i] =
+        Date{out_year, static_cast<Month>(month), static_cast<Day>(day)};
+  }
+} // julianPascha
+
+void gregorianPascha(const Year* years, Date* dates)
+{
+  for (std::size_t i{0}; i < kLanes; ++i) {
+    std::int32_t month{};
+    std::int32_t day{};
+    gregorianPaschaLanes(static_cast<std::int32_t>(years[i]), month, day);
+    dates[i] =
+        Date{years[i], static_cast<Month>(month), static_cast<Day>(day)};
+  }
+} // gregorianPascha
+
+#endif
+
+} // namespace pascha::simd
@@ -0,0 +1,63 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+
+#ifndef PASCHA_COMPUTUS_SIMD_H
+#define PASCHA_COMPUTUS_SIMD_H
+
+#include "pascha/calendar_conversion.h"
+#include "pascha/date.h"
+#include "pascha/typedefs.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Vector kernels for calculating Pascha for several years at once. These are
+// internal to pascha-lib and are used by the batch calculate of the
+// calculation methods. The kernels calculate with 32 bit lanes, so they only
+// accept the years for which every intermediate value fits; other years must
+// be calculated with the scalar code.
+
+namespace pascha::simd
+{
+
+// The number of years calculated by each call of a kernel.
+inline constexpr std::size_t kLanes{8};
+
+// The years for which julianPascha is exact. The upper limit keeps the Julian
+// Day Number within 32 bits.
+inline constexpr Year kJulianMinYear{pascha::kJulianMinYear};
+inline constexpr Year kJulianMaxYear{5000000};
+
+// The years for which gregorianPascha is exact.
+inline constexpr Year kGregorianMinYear{INT32_MIN};
+inline constexpr Year kGregorianMaxYear{INT32_MAX};
+
+// Calculate the Gregorian date of Pascha by the Julian computus for the kLanes
+// years starting at years, storing them in dates.
+void julianPascha(const Year* years, Date* dates);
+
+// Calculate the Gregorian date of Pascha by the Gregorian computus for the
+// kLanes years starting at years, storing them in dates.
+void gregorianPascha(const Year* years, Date* dates);
+
+} // namespace pascha::simd
+
+#endif // !PASCHA_COMPUTUS_SIMD_H
@@ -0,0 +1,191 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+
+#include "pascha/gregorian_table.h"
+
+#include "pascha/calculation_methods.h"
+#include "pascha/computus.h"
+
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// The default path of the table, set when building to where it is installed.
+#ifndef PASCHA_GREGORIAN_TABLE_PATH
+#define PASCHA_GREGORIAN_TABLE_PATH "gregorian_paschalion.bin"
+#endif
+
+// Helper functions for the table file
+namespace
+{
+using namespace pascha;
+
+constexpr std::array<char, 8> kMagic{'P', 'A', 'S', 'C', 'H', 'A', 'G', 'T'};
+constexpr std::size_t kTableFileSize{kGregorianTableHeaderSize +
+                                     kGregorianCycle};
+
+void putU32(std::array<char, kGregorianTableHeaderSize>& header,
+            std::size_t offset, std::uint32_t value)
+{
+  for (std::size_t i{0}; i < 4; ++i) {
+    header[offset + i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+} // putU32
+
+std::uint32_t getU32(const std::uint8_t* bytes, std::size_t offset)
+{
+  std::uint32_t value{0};
+  for (std::size_t i{0}; i < 4; ++i) {
+    value |= static_cast<std::uint32_t>(bytes[offset + i]) << (8 * i);
+  }
+  return value;
+} // getU32
+
+// Check that the mapped file is a table this version can read and that it has
+// not been corrupted.
+bool validTable(const std::uint8_t* bytes)
+{
+  for (std::size_t i{0}; i < kMagic.size(); ++i) {
+    if (bytes[i] != static_cast<std::uint8_t>(kMagic[i])) { return false; }
+  }
+  return getU32(bytes, 8) == kGregorianTableVersion &&
+         getU32(bytes, 12) == kGregorianCycle &&
+         getU32(bytes, 16) ==
+             gregorianTableChecksum(std::span{
+                 bytes + kGregorianTableHeaderSize,
+                 static_cast<std::size_t>(kGregorianCycle)});
+} // validTable
+
+// Look up the date of Pascha for a non-negative year.
+inline Date tablePascha(const std::uint8_t* table, Year year)
+{
+  CalcInt day{table[year % kGregorianCycle] + 21};
+  if (day > 31) { return Date{year, 4, static_cast<Day>(day - 31)}; }
+  return Date{year, 3, static_cast<Day>(day)};
+} // tablePascha
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+std::uint32_t gregorianTableChecksum(std::span<const std::uint8_t> table)
+{
+  // FNV-1a
+  std::uint32_t hash{2166136261u};
+  for (std::uint8_t byte : table) {
+    hash ^= byte;
+    hash *= 16777619u;
+  }
+  return hash;
+} // gregorianTableChecksum
+
+void writeGregorianTable(std::ostream& out)
+{
+  std::vector<std::uint8_t> table(kGregorianCycle);
+  for (Year year{0}; year < kGregorianCycle; ++year) {
+    Date date{gregorianPascha(year)};
+    table[year] = static_cast<std::uint8_t>(date.month == 3 ? date.day - 21
+                                                            : date.day + 10);
+  }
+
+  std::array<char, kGregorianTableHeaderSize> header{};
+  for (std::size_t i{0}; i < kMagic.size(); ++i) { header[i] = kMagic[i]; }
+  putU32(header, 8, kGregorianTableVersion);
+  putU32(header, 12, kGregorianCycle);
+  putU32(header, 16, gregorianTableChecksum(table));
+  putU32(header, 20, 0);
+
+  out.write(header.data(), header.size());
+  out.write(reinterpret_cast<const char*>(table.data()), table.size());
+} // writeGregorianTable
+
+std::string defaultGregorianTablePath()
+{
+  if (const char* path{std::getenv("PASCHA_GREGORIAN_TABLE")}) { return path; }
+  return PASCHA_GREGORIAN_TABLE_PATH;
+} // defaultGregorianTablePath
+
+MappedGregorianCalculationMethod::MappedGregorianCalculationMethod()
+    : MappedGregorianCalculationMethod{defaultGregorianTablePath()}
+{
+} // MappedGregorianCalculationMethod::MappedGregorianCalculationMethod
+
+MappedGregorianCalculationMethod::MappedGregorianCalculationMethod(
+    const std::string& path)
+{
+#if !defined(_WIN32)
+  int fd{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (fd < 0) { return; }
+
+  struct stat status{};
+  if (fstat(fd, &status) != 0 ||
+      static_cast<std::size_t>(status.st_size) != kTableFileSize) {
+    close(fd);
+    return;
+  }
+
+  void* mapping{mmap(nullptr, kTableFileSize, PROT_READ, MAP_SHARED, fd, 0)};
+  close(fd);
+  if (mapping == MAP_FAILED) { return; }
+
+  m_mapping = mapping;
+  m_mapping_size = kTableFileSize;
+
+  auto* bytes{static_cast<const std::uint8_t*>(mapping)};
+  if (validTable(bytes)) { m_table = bytes + kGregorianTableHeaderSize; }
+#endif
+} // MappedGregorianCalculationMethod::MappedGregorianCalculationMethod
+
+MappedGregorianCalculationMethod::~MappedGregorianCalculationMethod()
+{
+#if !defined(_WIN32)
+  if (m_mapping) { munmap(m_mapping, m_mapping_size); }
+#endif
+} // MappedGregorianCalculationMethod::~MappedGregorianCalculationMethod
+
+Checked<Date> MappedGregorianCalculationMethod::tryCalculate(Year year) const
+{
+  if (!m_table || year < 0) { return m_computus.tryCalculate(year); }
+  return {tablePascha(m_table, year)};
+} // MappedGregorianCalculationMethod::tryCalculate
+
+std::size_t MappedGregorianCalculationMethod::tryCalculate(
+    std::span<const Year> years, std::span<Date> dates,
+    std::span<EConversionError> errors) const
+{
+  if (!m_table) { return m_computus.tryCalculate(years, dates, errors); }
+
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    dates[i] = years[i] < 0 ? gregorianPascha(years[i])
+                            : tablePascha(m_table, years[i]);
+  }
+  return 0;
+} // MappedGregorianCalculationMethod::tryCalculate
+
+} // namespace pascha
@@ -0,0 +1,74 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+
+#ifndef PASCHA_JULIAN_PASCHALION_H
+#define PASCHA_JULIAN_PASCHALION_H
+
+#include "pascha/calendar_conversion.h"
+#include "pascha/computus.h"
+#include "pascha/typedefs.h"
+
+#include <array>
+#include <cstdint>
+
+// The Julian Paschalion repeats every 532 years, the product of the 19 year
+// lunar and 28 year solar cycles. These tables, internal to pascha-lib, hold
+// the day of Julian Pascha for each year of the cycle, counted in days after
+// 21 March in the Julian calendar. They are generated at compile time from the
+// computus in computus.h.
+
+namespace pascha::paschalion
+{
+
+inline constexpr Year kJulianCycle{532};
+
+using JulianTable = std::array<std::int8_t, kJulianCycle>;
+
+// Generate the table for the years sign * 0 to sign * 531. The computus uses
+// truncating remainders, so negative years repeat with -year % 532 rather than
+// with the remainders of the non-negative years, and need their own table.
+constexpr JulianTable makeJulianTable(Year sign)
+{
+  JulianTable table{};
+  for (Year i{0}; i < kJulianCycle; ++i) {
+    Year year{sign * i};
+    table[i] = static_cast<std::int8_t>(julianToJdn(julianPascha(year)) -
+                                        julianToJdn(Date{year, 3, 21}));
+  }
+  return table;
+} // makeJulianTable
+
+// Indexed by year % 532 for non-negative years.
+inline constexpr JulianTable kJulianTable{makeJulianTable(1)};
+
+// Indexed by -year % 532 for negative years.
+inline constexpr JulianTable kNegativeJulianTable{makeJulianTable(-1)};
+
+// The day of Julian Pascha after 21 March in the Julian calendar.
+constexpr CalcInt julianPaschaOffset(Year year)
+{
+  return year < 0 ? kNegativeJulianTable[-year % kJulianCycle]
+                  : kJulianTable[year % kJulianCycle];
+} // julianPaschaOffset
+
+} // namespace pascha::paschalion
+
+#endif // !PASCHA_JULIAN_PASCHALION_H
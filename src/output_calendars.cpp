@@ -25,19 +25,61 @@
 namespace pascha
 {
 
-Date JulianOutputCalendar::calculate(Year year) const
+Checked<Date> JulianOutputCalendar::tryCalculate(Year year) const
 {
-  return gregorianToJulian(calculation_method().calculate(year));
-} // JulianOutputCalendar::calculate
+  Checked<CalcInt> jdn{calculation_method().tryCalculateJdn(year)};
+  if (!jdn) { return {{}, jdn.error}; }
+  return {jdnToJulian(*jdn)};
+} // JulianOutputCalendar::tryCalculate
 
-Date GregorianOutputCalendar::calculate(Year year) const
+Checked<CalcInt> JulianOutputCalendar::tryCalculateJdn(Year year) const
 {
-  return calculation_method().calculate(year);
-} // GregorianOutputCalendar::calculate
+  return calculation_method().tryCalculateJdn(year);
+} // JulianOutputCalendar::tryCalculateJdn
 
-Date RevisedJulianOutputCalendar::calculate(Year year) const
+std::size_t JulianOutputCalendar::tryCalculate(
+    std::span<const Year> years, std::span<Date> dates,
+    std::span<EConversionError> errors) const
 {
-  return gregorianToRevJulian(calculation_method().calculate(year));
-} // JulianOutputCalendar::calculate
+  calculation_method().tryCalculate(years, dates, errors);
+  return tryGregorianToJulian(dates.first(years.size()), dates, errors);
+} // JulianOutputCalendar::tryCalculate
+
+Checked<Date> GregorianOutputCalendar::tryCalculate(Year year) const
+{
+  return calculation_method().tryCalculate(year);
+} // GregorianOutputCalendar::tryCalculate
+
+Checked<CalcInt> GregorianOutputCalendar::tryCalculateJdn(Year year) const
+{
+  return calculation_method().tryCalculateJdn(year);
+} // GregorianOutputCalendar::tryCalculateJdn
+
+std::size_t GregorianOutputCalendar::tryCalculate(
+    std::span<const Year> years, std::span<Date> dates,
+    std::span<EConversionError> errors) const
+{
+  return calculation_method().tryCalculate(years, dates, errors);
+} // GregorianOutputCalendar::tryCalculate
+
+Checked<Date> RevisedJulianOutputCalendar::tryCalculate(Year year) const
+{
+  Checked<CalcInt> jdn{calculation_method().tryCalculateJdn(year)};
+  if (!jdn) { return {{}, jdn.error}; }
+  return tryJdnToRevJulian(*jdn);
+} // RevisedJulianOutputCalendar::tryCalculate
+
+Checked<CalcInt> RevisedJulianOutputCalendar::tryCalculateJdn(Year year) const
+{
+  return calculation_method().tryCalculateJdn(year);
+} // RevisedJulianOutputCalendar::tryCalculateJdn
+
+std::size_t RevisedJulianOutputCalendar::tryCalculate(
+    std::span<const Year> years, std::span<Date> dates,
+    std::span<EConversionError> errors) const
+{
+  calculation_method().tryCalculate(years, dates, errors);
+  return tryGregorianToRevJulian(dates.first(years.size()), dates, errors);
+} // RevisedJulianOutputCalendar::tryCalculate
 
 } // namespace pascha
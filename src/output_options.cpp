@@ -23,12 +23,29 @@
 namespace pascha
 {
 
-Date ByzantineDate::calculate(Year year) const
+Checked<Date> ByzantineDate::tryCalculate(Year year) const
 {
-  Date date{calculation_method().calculate(year)};
-  date.year += 5508;
-  if (date.month > 8) { ++date.year; }
+  Checked<Date> date{calculation_method().tryCalculate(year)};
+  date.value.year += 5508;
+  if (date.value.month > 8) { ++date.value.year; }
   return date;
-} // ByzantineDate::calculate
+} // ByzantineDate::tryCalculate
+
+Checked<CalcInt> ByzantineDate::tryCalculateJdn(Year year) const
+{
+  return calculation_method().tryCalculateJdn(year);
+} // ByzantineDate::tryCalculateJdn
+
+std::size_t ByzantineDate::tryCalculate(
+    std::span<const Year> years, std::span<Date> dates,
+    std::span<EConversionError> errors) const
+{
+  std::size_t count{calculation_method().tryCalculate(years, dates, errors)};
+  for (Date& date : dates.first(years.size())) {
+    date.year += 5508;
+    if (date.month > 8) { ++date.year; }
+  }
+  return count;
+} // ByzantineDate::tryCalculate
 
 } // namespace pascha
@@ -22,80 +22,164 @@
 
 #include "pascha/calendar_conversion.h"
 
+#include <algorithm>
+#include <array>
 #include <ctime>
+#include <string_view>
+
+namespace
+{
+using namespace pascha;
+
+constexpr std::string_view kNoMethod{"No calculation method set!"};
+
+// Notify the value of a result, or else its error message.
+template <typename T>
+void notifyResult(const IObservable& observable, const Result<T>& result)
+{
+  if (result) {
+    observable.notify(*result);
+  } else {
+    observable.notify(result.message());
+  }
+} // notifyResult
+
+// The Result of a value whose date is out of the range of a calendar.
+template <typename T>
+Result<T> outOfRange(EConversionError error)
+{
+  return {e_calculation_error::out_of_range, conversionErrorMessage(error)};
+} // outOfRange
+
+} // anonymous namespace
 
 namespace pascha
 {
 
 void PaschaCalculatorModel::setCalculationMethod(
-    std::unique_ptr<ICalculationMethod> calculation_method)
+    std::shared_ptr<ICalculationMethod> calculation_method)
+{
+  setCalculationMethod(std::move(calculation_method), e_target_output::pascha);
+} // PaschaCalculatorModel::setCalculationMethod
+
+void PaschaCalculatorModel::setCalculationMethod(
+    std::shared_ptr<ICalculationMethod> calculation_method,
+    ETargetOutput target_output)
 {
   m_calculation_method = std::move(calculation_method);
-}
+  m_target_output = target_output;
+} // PaschaCalculatorModel::setCalculationMethod
 
 void PaschaCalculatorModel::calculate(Year year) const
 {
-  using namespace std::literals; // for sv
+  notifyResult(*this, calculateDate(year));
+} // PaschaCalculatorModel::calculate
 
+void PaschaCalculatorModel::calculate(std::span<const Year> years) const
+{
   if (!m_calculation_method) {
-    notify("No calculation method set!"sv);
+    notify(kNoMethod);
     return;
   }
 
-  try {
-    Date date = m_calculation_method->calculate(year);
-    notify(date);
-  } catch (const std::overflow_error& e) {
-    notify(e.what());
+  // Calculate in fixed size blocks so that the buffer stays small and hot in
+  // cache, however many years are given.
+  constexpr std::size_t kBlockSize{1024};
+  std::array<Date, kBlockSize> dates{};
+  std::array<EConversionError, kBlockSize> errors{};
+
+  while (!years.empty()) {
+    std::span<const Year> block{
+        years.first(std::min(years.size(), kBlockSize))};
+    years = years.subspan(block.size());
+
+    std::span<EConversionError> block_errors{errors.data(), block.size()};
+    std::fill(block_errors.begin(), block_errors.end(),
+              e_conversion_error::none);
+    if (m_calculation_method->tryCalculate(block, dates, block_errors) == 0) {
+      notify(std::span{dates}.first(block.size()),
+             DatesMetadata{block, m_target_output});
+      continue;
+    }
+
+    // Notify the runs of years between the errors as blocks, so that the
+    // valid years are still output in order, and each error in its place.
+    std::size_t first{0};
+    for (std::size_t i{0}; i <= block.size(); ++i) {
+      if (i < block.size() && block_errors[i] == e_conversion_error::none) {
+        continue;
+      }
+      if (i > first) {
+        notify(std::span{dates}.subspan(first, i - first),
+               DatesMetadata{block.subspan(first, i - first),
+                             m_target_output});
+      }
+      if (i < block.size()) {
+        notify(conversionErrorMessage(block_errors[i]));
+      }
+      first = i + 1;
+    }
   }
 } // PaschaCalculatorModel::calculate
 
 void PaschaCalculatorModel::daysUntil(Year year) const
 {
-  using namespace std::literals; // for sv
+  notifyResult(*this, calculateDaysUntil(year));
+} // PaschaCalculatorModel::daysUntil
+
+void PaschaCalculatorModel::weeksBetween(
+    Year year, std::shared_ptr<ICalculationMethod> method1,
+    std::shared_ptr<ICalculationMethod> method2) const
+{
+  notifyResult(*this, calculateWeeksBetween(year, std::move(method1),
+                                            std::move(method2)));
+} // PaschaCalculatorModel::weeksBetween
 
+Result<Date> PaschaCalculatorModel::calculateDate(Year year) const
+{
   if (!m_calculation_method) {
-    notify("No calculation method set!"sv);
-    return;
+    return {e_calculation_error::no_method, kNoMethod};
   }
 
-  try {
-    CalcInt dateJdn{gregorianToJdn(m_calculation_method->calculate(year))};
-
-    std::time_t t = std::time(0); // get time now
-    std::tm* now = std::localtime(&t);
-    Date nowDate{};
-    nowDate.year = now->tm_year + 1900;
-    nowDate.month = now->tm_mon + 1;
-    nowDate.day = now->tm_mday;
-    CalcInt nowJdn{gregorianToJdn(nowDate)};
+  Checked<Date> date{m_calculation_method->tryCalculate(year)};
+  if (!date) { return outOfRange<Date>(date.error); }
+  return *date;
+} // PaschaCalculatorModel::calculateDate
 
-    notify(Days{dateJdn - nowJdn});
-  } catch (const std::overflow_error& e) {
-    notify(e.what());
+Result<Days> PaschaCalculatorModel::calculateDaysUntil(Year year) const
+{
+  if (!m_calculation_method) {
+    return {e_calculation_error::no_method, kNoMethod};
   }
-} // PaschaCalculatorModel::daysUntil
 
-void PaschaCalculatorModel::weeksBetween(
-    Year year, std::unique_ptr<ICalculationMethod> method1,
-    std::unique_ptr<ICalculationMethod> method2) const
-{
-  using namespace std::literals; // for sv
+  Checked<CalcInt> jdn{m_calculation_method->tryCalculateJdn(year)};
+  if (!jdn) { return outOfRange<Days>(jdn.error); }
+
+  std::time_t t = std::time(0); // get time now
+  std::tm* now = std::localtime(&t);
+  Date nowDate{};
+  nowDate.year = now->tm_year + 1900;
+  nowDate.month = now->tm_mon + 1;
+  nowDate.day = now->tm_mday;
 
+  return Days{*jdn - gregorianToJdn(nowDate)};
+} // PaschaCalculatorModel::calculateDaysUntil
+
+Result<Weeks> PaschaCalculatorModel::calculateWeeksBetween(
+    Year year, std::shared_ptr<ICalculationMethod> method1,
+    std::shared_ptr<ICalculationMethod> method2) const
+{
   if (!method1 || !method2) {
-    notify("No calculation method set!"sv);
-    return;
+    return {e_calculation_error::no_method, kNoMethod};
   }
 
-  try {
-    CalcInt date1Jdn{gregorianToJdn(method1->calculate(year))};
-    CalcInt date2Jdn{gregorianToJdn(method2->calculate(year))};
+  Checked<CalcInt> jdn1{method1->tryCalculateJdn(year)};
+  if (!jdn1) { return outOfRange<Weeks>(jdn1.error); }
+  Checked<CalcInt> jdn2{method2->tryCalculateJdn(year)};
+  if (!jdn2) { return outOfRange<Weeks>(jdn2.error); }
 
-    notify(Weeks{(date1Jdn - date2Jdn) / 7});
-  } catch (const std::overflow_error& e) {
-    notify(e.what());
-  }
-} // PaschaCalculatorModel::weeksBetween
+  return Weeks{(*jdn1 - *jdn2) / 7};
+} // PaschaCalculatorModel::calculateWeeksBetween
 
 void PaschaCalculatorModel::addObserver(IObserver& observer)
 {
@@ -127,4 +211,12 @@ void PaschaCalculatorModel::notify(std::string_view message) const
   for (IObserver* observer : m_observers) { observer->update(message); }
 } // PaschaCalculatorModel::notify
 
+void PaschaCalculatorModel::notify(std::span<const Date> dates,
+                                   const DatesMetadata& metadata) const
+{
+  for (IObserver* observer : m_observers) {
+    observer->update(dates, metadata);
+  }
+} // PaschaCalculatorModel::notify
+
 } // namespace pascha
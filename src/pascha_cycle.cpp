@@ -0,0 +1,116 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha_cycle.h"
+
+#include "julian_paschalion.h"
+#include "pascha/computus.h"
+#include "pascha/gregorian_table.h"
+
+namespace
+{
+using namespace pascha;
+
+// The years of the cycle from 0 to `year`, which must be in the first cycle.
+std::uint64_t countUpTo(const std::vector<std::uint32_t>& years, Year year)
+{
+  return static_cast<std::uint64_t>(
+      std::upper_bound(years.begin(), years.end(), year) - years.begin());
+} // countUpTo
+
+// The years from 0 to `year` with Pascha on the offset, which is also the
+// years in whole cycles plus those in the first cycle up to the remainder.
+std::uint64_t countFromZero(const PaschaCycle& cycle, CalcInt offset,
+                            Year year)
+{
+  if (year < 0) { return 0; }
+  const std::vector<std::uint32_t>& years{cycle.years[offset - 1]};
+  return static_cast<std::uint64_t>(year / cycle.length) * years.size() +
+         countUpTo(years, year % cycle.length);
+} // countFromZero
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+const PaschaCycle& julianCycle()
+{
+  static const PaschaCycle cycle{[] {
+    PaschaCycle julian{paschalion::kJulianCycle, e_output_calendar::julian};
+    julian.offsets.reserve(static_cast<std::size_t>(julian.length));
+    for (Year year{0}; year < julian.length; ++year) {
+      julian.years[paschalion::kJulianTable[year] - 1].push_back(
+          static_cast<std::uint32_t>(year));
+      julian.offsets.push_back(
+          static_cast<std::uint8_t>(paschalion::kJulianTable[year]));
+    }
+    return julian;
+  }()};
+  return cycle;
+} // julianCycle
+
+const PaschaCycle& gregorianCycle()
+{
+  static const PaschaCycle cycle{[] {
+    PaschaCycle gregorian{kGregorianCycle, e_output_calendar::gregorian};
+    gregorian.offsets.reserve(static_cast<std::size_t>(gregorian.length));
+    for (Year year{0}; year < gregorian.length; ++year) {
+      Date pascha{gregorianPascha(year)};
+      CalcInt offset{pascha.month == 3 ? pascha.day - 21 : pascha.day + 10};
+      gregorian.years[offset - 1].push_back(static_cast<std::uint32_t>(year));
+      gregorian.offsets.push_back(static_cast<std::uint8_t>(offset));
+    }
+    return gregorian;
+  }()};
+  return cycle;
+} // gregorianCycle
+
+std::uint64_t countCycleYears(const PaschaCycle& cycle, CalcInt offset,
+                              Year from, Year to)
+{
+  from = std::max(from, Year{0});
+  if (from > to) { return 0; }
+  return countFromZero(cycle, offset, to) -
+         countFromZero(cycle, offset, from - 1);
+} // countCycleYears
+
+std::optional<Year> firstCycleYear(const PaschaCycle& cycle, CalcInt offset,
+                                   Year from, Year to)
+{
+  std::optional<Year> first{};
+  const std::vector<std::uint32_t>& years{cycle.years[offset - 1]};
+  from = std::max(from, Year{0});
+  if (years.empty() || from > to) { return first; }
+
+  // The first year on or after `from` is in its cycle, or else is the first
+  // of the next.
+  Year start{from - from % cycle.length};
+  auto year{std::lower_bound(years.begin(), years.end(), from - start)};
+  if (year == years.end()) {
+    if (to - start < cycle.length) { return first; }
+    start += cycle.length;
+    year = years.begin();
+  }
+  if (*year <= to - start) { first = start + *year; }
+  return first;
+} // firstCycleYear
+
+} // namespace pascha
@@ -0,0 +1,93 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_PASCHA_CYCLE_H
+#define PASCHA_PASCHA_CYCLE_H
+
+#include "pascha/calculation_options.h"
+#include "pascha/typedefs.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// The years of the cycle of each computus by their date of Pascha, internal
+// to pascha-lib, with which the years of any span that have Pascha on a date
+// are counted or listed without calculating the years in between.
+
+namespace pascha
+{
+
+// The number of days Pascha can fall on, from 22 March to 25 April.
+inline constexpr int kPaschaDays{35};
+
+struct PaschaCycle
+{
+  Year length;
+  // The calendar the computus gives the date in.
+  EOutputCalendar calendar;
+  // The years of the cycle, in increasing order, by the day of Pascha after 21
+  // March less one.
+  std::array<std::vector<std::uint32_t>, kPaschaDays> years{};
+  // The day of Pascha after 21 March of each year of the cycle.
+  std::vector<std::uint8_t> offsets{};
+}; // struct PaschaCycle
+
+// The cycles are built on first use, and shared from then on.
+const PaschaCycle& julianCycle();
+const PaschaCycle& gregorianCycle();
+
+// Call visit with each non-negative year from `from` to `to` whose Pascha is
+// the offset in days after 21 March of the calendar of the cycle, in order.
+template <typename Visit>
+void forEachCycleYear(const PaschaCycle& cycle, CalcInt offset, Year from,
+                      Year to, Visit visit)
+{
+  const std::vector<std::uint32_t>& years{cycle.years[offset - 1]};
+  if (years.empty() || from > to) { return; }
+  Year start{from - from % cycle.length};
+  auto year{std::lower_bound(years.begin(), years.end(), from - start)};
+  while (true) {
+    // Compared against the distance to `to`, so that a cycle reaching past the
+    // largest Year does not overflow.
+    for (; year != years.end(); ++year) {
+      if (*year > to - start) { return; }
+      visit(start + *year);
+    }
+    if (to - start < cycle.length) { return; }
+    start += cycle.length;
+    year = years.begin();
+  }
+} // forEachCycleYear
+
+// The number of non-negative years from `from` to `to` with Pascha on the
+// offset, counting the whole cycles between them at once.
+std::uint64_t countCycleYears(const PaschaCycle& cycle, CalcInt offset,
+                              Year from, Year to);
+
+// The first non-negative year from `from` to `to` with Pascha on the offset.
+std::optional<Year> firstCycleYear(const PaschaCycle& cycle, CalcInt offset,
+                                   Year from, Year to);
+
+} // namespace pascha
+
+#endif // !PASCHA_PASCHA_CYCLE_H
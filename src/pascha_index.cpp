@@ -0,0 +1,469 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/pascha_index.h"
+
+#include "pascha/calendar_conversion.h"
+#include "pascha/static_pipeline.h"
+#include "pascha_cycle.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using namespace pascha;
+
+// The days in each month, with 29 for February.
+constexpr std::array<Day, 12> kMonthDays{31, 29, 31, 30, 31, 30,
+                                         31, 31, 30, 31, 30, 31};
+
+// The day of the year counted from 1 March, which is 0, so that a leap day is
+// the last day of the year.
+constexpr CalcInt marchDay(Month month, Day day)
+{
+  return (153 * ((month + 9) % 12) + 2) / 5 + day - 1;
+} // marchDay
+
+// The days from 1 March to 31 February, which the Gregorian computus gives for
+// some negative years, as it does 30 February.
+constexpr CalcInt kMarchDays{368};
+
+// The inverse of marchDay, for days before the end of February.
+constexpr std::pair<Month, Day> fromMarchDay(CalcInt days)
+{
+  CalcInt month{(5 * days + 2) / 153};
+  CalcInt day{days - (153 * month + 2) / 5 + 1};
+  month = month < 10 ? month + 3 : month - 9;
+  return {static_cast<Month>(month), static_cast<Day>(day)};
+} // fromMarchDay
+
+// The JDN of a date in the calendar, which must be in range.
+CalcInt toJdn(EOutputCalendar calendar, const Date& date)
+{
+  switch (calendar) {
+    case e_output_calendar::gregorian: return unchecked::gregorianToJdn(date);
+    case e_output_calendar::rev_julian: return unchecked::revJulianToJdn(date);
+    default: return unchecked::julianToJdn(date);
+  }
+} // toJdn
+
+CalcInt marchFirst(EOutputCalendar calendar, Year year)
+{
+  return toJdn(calendar, Date{year, 3, 1});
+} // marchFirst
+
+// The leap days of the calendar before 1 March of the year, less a constant,
+// which does not overflow for any year as the JDN can.
+CalcInt leapDays(EOutputCalendar calendar, Year year)
+{
+  switch (calendar) {
+    case e_output_calendar::gregorian:
+      return floorDiv(year, 4) - floorDiv(year, 100) + floorDiv(year, 400);
+    case e_output_calendar::rev_julian:
+      return floorDiv(year, 4) - floorDiv(year, 100) +
+             floorDiv(year + 300, 900) + floorDiv(year + 700, 900);
+    default: return floorDiv(year, 4);
+  }
+} // leapDays
+
+// The days from 1 March of the year in the output calendar to 1 March of the
+// year in that of the computus, which only changes in the first year of a
+// century, and then by at most a day.
+CalcInt calendarDrift(EOutputCalendar computus, EOutputCalendar output,
+                      Year year)
+{
+  return marchFirst(computus, 0) - marchFirst(output, 0) +
+         leapDays(computus, year) - leapDays(computus, 0) -
+         leapDays(output, year) + leapDays(output, 0);
+} // calendarDrift
+
+// The days in a number of years of the calendar, which are within 5 days of
+// the days in that many years from 1 March of any year: the leap years of each
+// calendar are a sum of at most four floored divisions of the year, each of
+// which is less than a day from its mean.
+CalcInt yearsLength(EOutputCalendar calendar, CalcInt years)
+{
+  switch (calendar) {
+    case e_output_calendar::gregorian:
+      return 365 * years + floorDiv(97 * years, 400);
+    case e_output_calendar::rev_julian:
+      return 365 * years + floorDiv(218 * years, 900);
+    default: return 365 * years + floorDiv(years, 4);
+  }
+} // yearsLength
+
+// The mean length of a year of the calendar, as days per number of years.
+std::pair<CalcInt, CalcInt> meanYear(EOutputCalendar calendar)
+{
+  switch (calendar) {
+    case e_output_calendar::gregorian: return {146097, 400};
+    case e_output_calendar::rev_julian: return {328718, 900};
+    default: return {1461, 4};
+  }
+} // meanYear
+
+// The date of a JDN in the calendar.
+Date fromJdn(EOutputCalendar calendar, CalcInt jdn)
+{
+  switch (calendar) {
+    case e_output_calendar::gregorian: return jdnToGregorian(jdn);
+    case e_output_calendar::rev_julian: return unchecked::jdnToRevJulian(jdn);
+    default: return jdnToJulian(jdn);
+  }
+} // fromJdn
+
+// Counts the years on each date for PaschaIndex::statistics, by its day from 1
+// March, and the first years with the earliest and latest Pascha by the days
+// after 1 March of their year.
+class DateCounter
+{
+ public:
+  explicit DateCounter(PaschaStatistics& statistics) : m_statistics{statistics}
+  {}
+
+  // Count years on the date, the first of which is `first`, which are known
+  // not to have the earliest or latest Pascha.
+  void add(Month month, Day day, std::uint64_t years, Year first)
+  {
+    PaschaStatistics::DateCount& count{m_counts[marchDay(month, day)]};
+    if (count.years == 0 || first < count.first) { count.first = first; }
+    count.month = month;
+    count.day = day;
+    count.years += years;
+    m_statistics.years += years;
+  } // add
+
+  // Count years on the date whose Pascha is `days` after 1 March of the year.
+  void add(CalcInt days, Month month, Day day, std::uint64_t years, Year first)
+  {
+    add(month, day, years, first);
+    if (days < m_earliest ||
+        (days == m_earliest && first < m_statistics.earliest)) {
+      m_earliest = days;
+      m_statistics.earliest = first;
+    }
+    if (days > m_latest || (days == m_latest && first < m_statistics.latest)) {
+      m_latest = days;
+      m_statistics.latest = first;
+    }
+  } // add
+
+  // Give the statistics the dates counted, in the order of the year.
+  void finish()
+  {
+    for (const PaschaStatistics::DateCount& count : m_counts) {
+      if (count.years != 0) { m_statistics.dates.push_back(count); }
+    }
+  } // finish
+
+ private:
+  PaschaStatistics& m_statistics;
+  std::array<PaschaStatistics::DateCount, kMarchDays> m_counts{};
+  CalcInt m_earliest{std::numeric_limits<CalcInt>::max()};
+  CalcInt m_latest{std::numeric_limits<CalcInt>::min()};
+}; // class DateCounter
+
+// Count the years of `count` whole cycles from the cycle `first` by their date
+// of Pascha in the output calendar, which repeat every `days` JDNs.
+//
+// The JDN of Pascha of a year of the cycle moves by the same step each cycle,
+// so modulo `days` it goes round the residues of its coset of the step, and the
+// years of every cycle are counted from the residues they start at, at a cost
+// in proportion to the cycle and `days` however many cycles there are. The
+// earliest and latest Pascha are in the first and last cycles of the span,
+// which are calculated year by year, as the drift moves Pascha by days each
+// cycle, and are not counted here.
+void countCycles(const PaschaCycle& cycle, EOutputCalendar output, Year first,
+                 Year count, DateCounter& counter)
+{
+  const CalcInt days{meanYear(output).first};
+  const Year start{first * cycle.length};
+
+  // The years of the first cycle by the residue of their JDN of Pascha, with
+  // the first of them.
+  std::vector<std::uint64_t> starts(static_cast<std::size_t>(days));
+  std::vector<Year> firsts(static_cast<std::size_t>(days));
+  for (Year year{0}; year < cycle.length; ++year) {
+    auto residue{static_cast<std::size_t>(
+        floorMod(marchFirst(cycle.calendar, start + year) + 20 +
+                     cycle.offsets[static_cast<std::size_t>(year)],
+                 days))};
+    if (starts[residue]++ == 0) { firsts[residue] = start + year; }
+  }
+  const CalcInt step{floorMod(marchFirst(cycle.calendar, start + cycle.length) -
+                                  marchFirst(cycle.calendar, start),
+                              days)};
+  const CalcInt cosets{std::gcd(step, days)};
+  const CalcInt period{days / cosets};
+  const Year rounds{count / period};
+  const CalcInt rest{count % period};
+
+  // The years on each residue are those that start up to `count` - 1 steps
+  // before it: every residue of its coset `rounds` times, and then those that
+  // start up to `rest` - 1 steps before it.
+  std::vector<std::size_t> residues(static_cast<std::size_t>(period));
+  for (CalcInt coset{0}; coset < cosets; ++coset) {
+    std::uint64_t total{0};
+    CalcInt residue{coset};
+    for (std::size_t& position : residues) {
+      position = static_cast<std::size_t>(residue);
+      total += starts[position];
+      residue = (residue + step) % days;
+    }
+    if (total == 0) { continue; }
+
+    // Go round twice, so that the window and the last residue with years that
+    // start on it are known for each residue on the second time round.
+    std::uint64_t window{0};
+    CalcInt last{-1};
+    for (CalcInt i{0}; i < 2 * period; ++i) {
+      std::size_t position{residues[static_cast<std::size_t>(i % period)]};
+      window += starts[position];
+      if (i >= rest) {
+        window -=
+            starts[residues[static_cast<std::size_t>((i - rest) % period)]];
+      }
+      if (starts[position] != 0) { last = i; }
+      Year behind{i - last};
+      if (i < period || last < 0 || behind >= count) { continue; }
+
+      std::uint64_t years{static_cast<std::uint64_t>(rounds) * total + window};
+      Date date{fromJdn(output, static_cast<CalcInt>(position))};
+      counter.add(date.month, date.day, years,
+                  firsts[residues[static_cast<std::size_t>(last % period)]] +
+                      behind * cycle.length);
+    }
+  }
+} // countCycles
+
+// Count the years from `from` to `to`, which are not negative, by their date
+// of Pascha in an output calendar other than that of the computus.
+void countDriftedYears(const PaschaCycle& cycle, EOutputCalendar output,
+                       Year from, Year to, DateCounter& counter)
+{
+  auto countYears{[&](Year first, Year last) {
+    for (Year year{first}; year <= last; ++year) {
+      CalcInt jdn{marchFirst(cycle.calendar, year) + 20 +
+                  cycle.offsets[static_cast<std::size_t>(year % cycle.length)]};
+      Date date{fromJdn(output, jdn)};
+      counter.add(jdn - marchFirst(output, year), date.month, date.day, 1,
+                  year);
+    }
+  }};
+
+  // The drift moves Pascha the same way by a few days or more each cycle, so
+  // the earliest and the latest are within a cycle of the ends of the span.
+  // The years there are calculated, and the whole cycles between them counted
+  // at once.
+  Year middle{(from / cycle.length + (from % cycle.length == 0 ? 1 : 2)) *
+              cycle.length};
+  Year end{((to + 1) / cycle.length - 1) * cycle.length};
+  if (middle >= end) {
+    countYears(from, to);
+    return;
+  }
+  countYears(from, middle - 1);
+  countCycles(cycle, output, middle / cycle.length,
+              (end - middle) / cycle.length, counter);
+  countYears(end, to);
+} // countDriftedYears
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+PaschaIndex::PaschaIndex(ECalculationMethod calculation_method,
+                         EOutputCalendar output_calendar)
+    : m_output_calendar{output_calendar},
+      m_pascha{makeStaticPipeline(calculation_method, e_target_output::pascha,
+                                  output_calendar, false)},
+      m_cycle{calculation_method == e_calculation_method::gregorian
+                  ? gregorianCycle()
+                  : julianCycle()}
+{
+  if (!m_pascha) {
+#if defined(__cpp_exceptions)
+    throw std::invalid_argument("Unknown calculation method");
+#else
+    std::abort();
+#endif
+  }
+
+  auto calculable{
+      [this](Year year) { return m_pascha->tryCalculate(year).ok(); }};
+
+  // Only the years past the range of the calendars can not be calculated, so
+  // the last year that can be is found by bisection.
+  Year good{0};
+  Year bad{std::numeric_limits<Year>::max()};
+  if (calculable(bad)) {
+    good = bad;
+  }
+  while (bad - good > 1) {
+    Year middle{good + (bad - good) / 2};
+    (calculable(middle) ? good : bad) = middle;
+  }
+  m_last_year = good;
+  m_earlier_years = calculable(Year{kGregorianMinYear} - 1);
+
+  for (Year year{kGregorianMinYear}; year < 0; ++year) {
+    Checked<Date> date{m_pascha->tryCalculate(year)};
+    m_negative_years.push_back(date ? *date : Date{year, 0, 0});
+  }
+} // PaschaIndex::PaschaIndex(ECalculationMethod, EOutputCalendar)
+
+void PaschaIndex::forEachYear(Month month, Day day, Year from, Year to,
+                              const std::function<void(Year)>& visit) const
+{
+  if (month < 1 || month > 12 || day < 1 || day > kMonthDays[month - 1]) {
+    return;
+  }
+  from = std::max(from, Year{kGregorianMinYear});
+  to = std::min(to, m_last_year);
+
+  for (Year year{from}; year <= std::min(to, Year{-1}); ++year) {
+    const Date& date{m_negative_years[year - kGregorianMinYear]};
+    if (date.month == month && date.day == day) { visit(year); }
+  }
+  from = std::max(from, Year{0});
+  if (from > to) { return; }
+
+  if (m_output_calendar != m_cycle.calendar) {
+    forEachDriftedYear(month, day, from, to, visit);
+    return;
+  }
+  CalcInt offset{marchDay(month, day) - 20};
+  if (offset >= 1 && offset <= kPaschaDays) {
+    forEachCycleYear(m_cycle, offset, from, to, visit);
+  }
+} // PaschaIndex::forEachYear(Month, Day, Year, Year, ...) const
+
+std::vector<Year> PaschaIndex::findYears(Month month, Day day, Year from,
+                                         Year to) const
+{
+  std::vector<Year> years{};
+  forEachYear(month, day, from, to,
+              [&years](Year year) { years.push_back(year); });
+  return years;
+} // PaschaIndex::findYears(Month, Day, Year, Year) const
+
+PaschaStatistics PaschaIndex::statistics(Year from, Year to) const
+{
+  PaschaStatistics statistics{};
+  DateCounter counter{statistics};
+  from = std::max(from, Year{kGregorianMinYear});
+  to = std::min(to, m_last_year);
+
+  for (Year year{from}; year <= std::min(to, Year{-1}); ++year) {
+    const Date& date{m_negative_years[year - kGregorianMinYear]};
+    if (date.month != 0) {
+      counter.add(toJdn(m_output_calendar, date) -
+                      marchFirst(m_output_calendar, year),
+                  date.month, date.day, 1, year);
+    }
+  }
+  from = std::max(from, Year{0});
+
+  // In the calendar of the computus each date is counted over the whole span
+  // at once, and in another by the cycles of the computus and the calendar.
+  if (m_output_calendar != m_cycle.calendar) {
+    countDriftedYears(m_cycle, m_output_calendar, from, to, counter);
+  } else {
+    for (CalcInt offset{1}; offset <= kPaschaDays; ++offset) {
+      std::uint64_t years{countCycleYears(m_cycle, offset, from, to)};
+      if (years == 0) { continue; }
+      auto [month, day] = fromMarchDay(20 + offset);
+      counter.add(20 + offset, month, day, years,
+                  *firstCycleYear(m_cycle, offset, from, to));
+    }
+  }
+
+  counter.finish();
+  return statistics;
+} // PaschaIndex::statistics(Year, Year) const
+
+void PaschaIndex::forEachDriftedYear(
+    Month month, Day day, Year from, Year to,
+    const std::function<void(Year)>& visit) const
+{
+  // Pascha of year Y, offset days after 21 March of the calendar of the
+  // computus, is on the target day of year Y + k of the output calendar when
+  //
+  //   offset + 20 + drift(Y) == target + length(Y, k)
+  //
+  // where drift(Y) is the days from 1 March of Y in the output calendar to 1
+  // March of Y in that of the computus, and length(Y, k) the days from 1 March
+  // of Y to 1 March of Y + k in the output calendar.
+  const CalcInt target{marchDay(month, day)};
+  const auto [mean_days, mean_years] = meanYear(m_output_calendar);
+  std::vector<Year> candidates{};
+
+  Year century{from - from % 100};
+  while (century <= to) {
+    CalcInt drift{calendarDrift(m_cycle.calendar, m_output_calendar, century)};
+    Year first{std::max(century, from)};
+    Year last{std::min(century + 99, to)};
+
+    // As length(Y, k) is within 5 days of yearsLength(k), Pascha can only be
+    // on the target day when the drift is in a window around it for some k,
+    // of which only the nearest can matter. The years of the century are only
+    // searched if it is, and otherwise the centuries that the drift can not
+    // reach the window in are skipped.
+    CalcInt nearest{floorDiv((drift - target + 38) * mean_years, mean_days)};
+    CalcInt gap{std::numeric_limits<CalcInt>::max()};
+    for (CalcInt k{nearest - 1}; k <= nearest + 1; ++k) {
+      CalcInt low{target + yearsLength(m_output_calendar, k) - 60};
+      CalcInt high{target + yearsLength(m_output_calendar, k) - 16};
+      gap = std::min(gap, std::max({low - drift, drift - high, CalcInt{0}}));
+      if (drift < low || drift > high) { continue; }
+
+      // Within the century length(Y, k) is within 2 days of its value for the
+      // first year, and every candidate is checked.
+      CalcInt length{365 * k + leapDays(m_output_calendar, century + k) -
+                     leapDays(m_output_calendar, century)};
+      CalcInt offset{target + length - drift - 20};
+      for (CalcInt o{std::max(offset - 3, CalcInt{1})};
+           o <= std::min(offset + 3, CalcInt{kPaschaDays}); ++o) {
+        forEachCycleYear(m_cycle, o, first, last,
+                         [&candidates](Year year) {
+                           candidates.push_back(year);
+                         });
+      }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    for (Year year : candidates) {
+      Date date{m_pascha->calculate(year)};
+      if (date.month == month && date.day == day) { visit(year); }
+    }
+    candidates.clear();
+    century += 100 * std::max(gap, CalcInt{1});
+  }
+} // PaschaIndex::forEachDriftedYear(Month, Day, Year, Year, ...) const
+
+} // namespace pascha
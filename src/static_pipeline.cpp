@@ -0,0 +1,164 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+
+#include "pascha/static_pipeline.h"
+
+#include "pascha/target_dates.h"
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace
+{
+using namespace pascha;
+
+using Factory = std::shared_ptr<ICalculationMethod> (*)();
+
+// The shift of each date target, in the order of their indices in the table.
+constexpr std::array<int, 8> kShifts{
+    0,
+    kMeatfareShift,
+    kCheesefareShift,
+    kAshWednesdayShift,
+    kMidfeastPentecostShift,
+    kLeavetakingPaschaShift,
+    kAscensionShift,
+    kPentecostShift,
+};
+
+using Computuses =
+    std::tuple<pipeline::JulianComputus, pipeline::GregorianComputus>;
+// In the order of e_output_calendar.
+using Calendars = std::tuple<pipeline::JulianCalendar,
+                             pipeline::GregorianCalendar,
+                             pipeline::RevisedJulianCalendar>;
+
+constexpr std::size_t kCalendars{std::tuple_size_v<Calendars>};
+constexpr std::size_t kTableSize{std::tuple_size_v<Computuses> *
+                                 kShifts.size() * kCalendars * 2};
+
+constexpr std::size_t tableIndex(std::size_t computus, std::size_t shift,
+                                 std::size_t calendar, bool byzantine)
+{
+  return ((computus * kShifts.size() + shift) * kCalendars + calendar) * 2 +
+         byzantine;
+} // tableIndex
+
+template <std::size_t I>
+std::shared_ptr<ICalculationMethod> makeAt()
+{
+  using Computus = std::tuple_element_t<I / (kShifts.size() * kCalendars * 2),
+                                        Computuses>;
+  using Calendar = std::tuple_element_t<I / 2 % kCalendars, Calendars>;
+  constexpr int shift{kShifts[I / (kCalendars * 2) % kShifts.size()]};
+  return std::make_shared<
+      StaticPipeline<Computus, shift, Calendar, I % 2 == 1>>();
+} // makeAt
+
+// The finish does not depend on the computus, so these are indexed as the
+// table is for the first computus.
+template <std::size_t I>
+constexpr PipelineFinish finishAt()
+{
+  using Calendar = std::tuple_element_t<I / 2 % kCalendars, Calendars>;
+  constexpr int shift{kShifts[I / (kCalendars * 2)]};
+  return &StaticPipeline<pipeline::GregorianComputus, shift, Calendar,
+                         I % 2 == 1>::tryFinish;
+} // finishAt
+
+template <std::size_t... I>
+constexpr std::array<Factory, sizeof...(I)>
+    makeTable(std::index_sequence<I...>)
+{
+  return {&makeAt<I>...};
+} // makeTable
+
+template <std::size_t... I>
+constexpr std::array<PipelineFinish, sizeof...(I)>
+    makeFinishTable(std::index_sequence<I...>)
+{
+  return {finishAt<I>()...};
+} // makeFinishTable
+
+constexpr std::array<Factory, kTableSize> kTable{
+    makeTable(std::make_index_sequence<kTableSize>{})};
+constexpr std::array<PipelineFinish, kShifts.size() * kCalendars * 2>
+    kFinishTable{makeFinishTable(
+        std::make_index_sequence<kShifts.size() * kCalendars * 2>{})};
+
+// The index of the shift of a date target, or kShifts.size() for any other
+// target.
+std::size_t shiftIndex(ETargetOutput target_output)
+{
+  switch (target_output) {
+    case e_target_output::pascha: return 0;
+    case e_target_output::meatfare: return 1;
+    case e_target_output::cheesefare: return 2;
+    case e_target_output::ashWednesday: return 3;
+    case e_target_output::midfeastPentecost: return 4;
+    case e_target_output::leavetakingPascha: return 5;
+    case e_target_output::ascension: return 6;
+    case e_target_output::pentecost: return 7;
+    default: return kShifts.size();
+  }
+} // shiftIndex
+
+std::size_t calendarIndex(EOutputCalendar output_calendar)
+{
+  switch (output_calendar) {
+    case e_output_calendar::gregorian: return 1;
+    case e_output_calendar::rev_julian: return 2;
+    default: return 0;
+  }
+} // calendarIndex
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+std::shared_ptr<ICalculationMethod>
+    makeStaticPipeline(ECalculationMethod calculation_method,
+                       ETargetOutput target_output,
+                       EOutputCalendar output_calendar, bool byzantine)
+{
+  std::size_t shift{shiftIndex(target_output)};
+  if (shift == kShifts.size()) { return nullptr; }
+  std::size_t computus{
+      calculation_method == e_calculation_method::gregorian ? 1u : 0u};
+
+  return kTable[tableIndex(computus, shift, calendarIndex(output_calendar),
+                           byzantine)]();
+} // makeStaticPipeline
+
+PipelineFinish staticPipelineFinish(ETargetOutput target_output,
+                                    EOutputCalendar output_calendar,
+                                    bool byzantine)
+{
+  std::size_t shift{shiftIndex(target_output)};
+  if (shift == kShifts.size()) { return nullptr; }
+  return kFinishTable[tableIndex(0, shift, calendarIndex(output_calendar),
+                                 byzantine)];
+} // staticPipelineFinish
+
+} // namespace pascha
@@ -20,30 +20,38 @@
 
 #include "pascha/target_date.h"
 
-#include <ctime>
+#include "pascha/calendar_conversion.h"
 
 namespace pascha
 {
 
-void TargetDate::shift(int days, Date& date) const
+Checked<Date> TargetDate::tryCalculate(Year year) const
 {
-  std::tm t{};
-  t.tm_year = date.year - 1900;
-  t.tm_mon = date.month - 1;
-  t.tm_mday = date.day + days;
-
-  std::mktime(&t);
+  Checked<CalcInt> jdn{calculation_method().tryCalculateJdn(year)};
+  if (!jdn) { return {{}, jdn.error}; }
+  return {jdnToGregorian(*jdn + m_shift_amount)};
+}
 
-  date.year = t.tm_year + 1900;
-  date.month = t.tm_mon + 1;
-  date.day = t.tm_mday;
+Checked<CalcInt> TargetDate::tryCalculateJdn(Year year) const
+{
+  Checked<CalcInt> jdn{calculation_method().tryCalculateJdn(year)};
+  if (!jdn) { return jdn; }
+  return tryCheckGregorianJdn(*jdn + m_shift_amount);
 }
 
-Date TargetDate::calculate(Year year) const
+std::size_t TargetDate::tryCalculate(std::span<const Year> years,
+                                     std::span<Date> dates,
+                                     std::span<EConversionError> errors) const
 {
-  Date date = calculation_method().calculate(year);
-  shift(m_shift_amount, date);
-  return date;
+  calculation_method().tryCalculate(years, dates, errors);
+  std::size_t count{0};
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    Checked<CalcInt> jdn{tryGregorianToJdn(dates[i])};
+    dates[i] = jdnToGregorian(jdn.value + m_shift_amount);
+    errors[i] = errors[i] != e_conversion_error::none ? errors[i] : jdn.error;
+    count += errors[i] != e_conversion_error::none;
+  }
+  return count;
 }
 
 } // namespace pascha
@@ -0,0 +1,425 @@
+// Copyright (C) 2022, 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "pascha/weeks_between.h"
+
+#include "julian_paschalion.h"
+#include "pascha/calculation_methods.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/gregorian_table.h"
+#include "pascha_cycle.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+using namespace pascha;
+
+// The most that the days between the dates of Pascha can differ from the drift
+// between the calendars, from 22 March to 25 April.
+inline constexpr CalcInt kMaxOffset{34};
+
+// The years after which both computus repeat, over which the drift grows by
+// whole weeks, 3 days in every 400 years.
+inline constexpr Year kWeeksCycle{
+    std::lcm(paschalion::kJulianCycle, kGregorianCycle)};
+inline constexpr CalcInt kCycleDrift{julianGregorianDrift(kWeeksCycle) -
+                                     julianGregorianDrift(0)};
+static_assert(kWeeksCycle % 400 == 0 && kCycleDrift % 7 == 0);
+inline constexpr CalcInt kCycleWeeks{kCycleDrift / 7};
+
+using WeeksCount = WeeksBetweenStatistics::WeeksCount;
+
+// Call f with each year from `from` to `to` that can be calculated and the
+// weeks between its dates, calculating each of them.
+template <typename F>
+void forEachYearWeeks(Year from, Year to, F f)
+{
+  const JulianCalculationMethod julian{};
+  const GregorianCalculationMethod gregorian{};
+  for (Year year{from}; year <= to; ++year) {
+    // Years outside the range of the calendars are skipped.
+    Checked<CalcInt> julian_jdn{julian.tryCalculateJdn(year)};
+    Checked<CalcInt> gregorian_jdn{gregorian.tryCalculateJdn(year)};
+    if (julian_jdn && gregorian_jdn) {
+      f(year, Weeks{(*julian_jdn - *gregorian_jdn) / 7});
+    }
+    // to may be the largest Year.
+    if (year == to) { break; }
+  }
+} // forEachYearWeeks
+
+// Call visit with each year from `from` to `to` that is `weeks` apart,
+// calculating each of them.
+void scanYears(Weeks weeks, Year from, Year to,
+               const std::function<void(Year)>& visit)
+{
+  forEachYearWeeks(from, to, [&](Year year, Weeks year_weeks) {
+    if (year_weeks.value == weeks.value) { visit(year); }
+  });
+} // scanYears
+
+// The sum of floorDiv(year, divisor) over the years from 0 to `to`, which is
+// divisor times a triangular number for the whole multiples of the divisor,
+// and the rest for the last. It is a long double, as it would overflow.
+long double sumFloorDiv(Year to, CalcInt divisor)
+{
+  long double quotient{static_cast<long double>((to + 1) / divisor)};
+  long double remainder{static_cast<long double>((to + 1) % divisor)};
+  return divisor * quotient * (quotient - 1) / 2 + quotient * remainder;
+} // sumFloorDiv
+
+// The sum of the days of Pascha after 21 March over the years from `from` to
+// `to`, which must not be negative, from the whole cycles of the computus.
+long double sumOffsets(const PaschaCycle& cycle, Year from, Year to)
+{
+  long double sum{0};
+  for (CalcInt offset{1}; offset <= kPaschaDays; ++offset) {
+    sum += static_cast<long double>(offset) *
+           static_cast<long double>(countCycleYears(cycle, offset, from, to));
+  }
+  return sum;
+} // sumOffsets
+
+// The last year in which both dates can be calculated, past which the Julian
+// date is out of the range of the calendars, found by bisection.
+Year lastYear()
+{
+  static const Year last{[] {
+    Year good{0};
+    Year bad{std::numeric_limits<Year>::max()};
+    while (bad - good > 1) {
+      Year middle{good + (bad - good) / 2};
+      bool calculable{false};
+      forEachYearWeeks(middle, middle,
+                       [&calculable](Year, Weeks) { calculable = true; });
+      (calculable ? good : bad) = middle;
+    }
+    return good;
+  }()};
+  return last;
+} // lastYear
+
+// The weeks between the dates of a non-negative year, from the days of each
+// Pascha after 21 March in the cycles of the computus.
+Weeks cycleWeeks(const PaschaCycle& gregorian, Year year)
+{
+  return Weeks{(julianGregorianDrift(year) +
+                paschalion::julianPaschaOffset(year) -
+                gregorian.offsets[static_cast<std::size_t>(
+                    year % gregorian.length)]) /
+               7};
+} // cycleWeeks
+
+// The first year from `from` to `to` whose drift is at least `drift`, or the
+// year after `to` if there is none, found by bisection.
+Year firstDriftYear(Year from, Year to, CalcInt drift)
+{
+  Year last{to + 1};
+  while (from < last) {
+    Year middle{from + (last - from) / 2};
+    if (julianGregorianDrift(middle) < drift) {
+      from = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  return from;
+} // firstDriftYear
+
+// The years on each of a few consecutive numbers of weeks, and the first of
+// them, counted a year at a time.
+class WeeksHistogram
+{
+ public:
+  void add(Year year, Weeks weeks)
+  {
+    if (m_counts.empty()) { m_least = weeks.value; }
+    if (weeks.value < m_least) {
+      m_counts.insert(m_counts.begin(),
+                      static_cast<std::size_t>(m_least - weeks.value),
+                      WeeksCount{});
+      m_least = weeks.value;
+    }
+    auto index{static_cast<std::size_t>(weeks.value - m_least)};
+    if (index >= m_counts.size()) { m_counts.resize(index + 1); }
+    WeeksCount& count{m_counts[index]};
+    if (count.years == 0 || year < count.first) { count.first = year; }
+    count.weeks = weeks;
+    ++count.years;
+  }
+
+  // The count of a number of weeks, which has no years if it is not counted.
+  WeeksCount count(CalcInt weeks) const
+  {
+    if (weeks < m_least ||
+        weeks - m_least >= static_cast<CalcInt>(m_counts.size())) {
+      return WeeksCount{Weeks{weeks}};
+    }
+    return m_counts[static_cast<std::size_t>(weeks - m_least)];
+  }
+
+  CalcInt least() const { return m_least; }
+  CalcInt most() const
+  {
+    return m_least + static_cast<CalcInt>(m_counts.size()) - 1;
+  }
+
+ private:
+  CalcInt m_least{0};
+  std::vector<WeeksCount> m_counts{};
+}; // class WeeksHistogram
+
+// The years of the cycle from kWeeksCycle on each number of weeks, which is
+// built on first use. The weeks between the dates of a year of the cycle are
+// also those of the years a whole number of cycles after it, plus kCycleWeeks
+// for each, as well as those of the year a cycle before it when that is
+// positive.
+const WeeksHistogram& weeksCycle()
+{
+  static const WeeksHistogram cycle{[] {
+    const PaschaCycle& gregorian{gregorianCycle()};
+    WeeksHistogram histogram{};
+    for (Year year{kWeeksCycle}; year < 2 * kWeeksCycle; ++year) {
+      histogram.add(year, cycleWeeks(gregorian, year));
+    }
+    return histogram;
+  }()};
+  return cycle;
+} // weeksCycle
+
+// The count of a number of weeks over every non-negative year, from the cycle,
+// for a number of weeks that is positive.
+WeeksCount countCycleWeeks(CalcInt weeks)
+{
+  const WeeksHistogram& cycle{weeksCycle()};
+  WeeksCount count{Weeks{weeks}};
+  // The cycle holds a little more than kCycleWeeks numbers of weeks, so the
+  // weeks are in at most two cycles.
+  CalcInt cycles{floorDiv(weeks - cycle.least(), kCycleWeeks) - 1};
+  for (CalcInt shift{cycles}; shift <= cycles + 1; ++shift) {
+    CalcInt base{weeks - shift * kCycleWeeks};
+    if (shift < -1 || base > cycle.most()) { continue; }
+    WeeksCount in_cycle{cycle.count(base)};
+    if (in_cycle.years == 0) { continue; }
+    Year first{in_cycle.first + shift * kWeeksCycle};
+    if (count.years == 0 || first < count.first) { count.first = first; }
+    count.years += in_cycle.years;
+  }
+  return count;
+} // countCycleWeeks
+
+} // anonymous namespace
+
+namespace pascha
+{
+
+void forEachWeeksBetween(Weeks weeks, Year from, Year to,
+                         const std::function<void(Year)>& visit)
+{
+  // No year before the Gregorian calendar can be calculated.
+  from = std::max(from, Year{kGregorianMinYear});
+  if (from > to) { return; }
+  if (from < 0) {
+    scanYears(weeks, from, std::min(to, Year{-1}), visit);
+    from = 0;
+    if (from > to) { return; }
+  }
+
+  // No drift is near enough to so many weeks, and 7 times it may overflow.
+  constexpr CalcInt kMaxWeeks{std::numeric_limits<CalcInt>::max() / 8};
+  if (weeks.value > kMaxWeeks || weeks.value < -kMaxWeeks) { return; }
+  const CalcInt low{7 * weeks.value - kMaxOffset};
+  const CalcInt high{7 * weeks.value + kMaxOffset};
+
+  // Find the first year whose drift reaches the window by bisection, and
+  // calculate each year from there until the drift passes it.
+  if (julianGregorianDrift(to) < low) { return; }
+  Year first{from};
+  Year last{to};
+  while (first < last) {
+    Year middle{first + (last - first) / 2};
+    if (julianGregorianDrift(middle) < low) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  if (julianGregorianDrift(first) > high) { return; }
+
+  // The drift only changes in the first year of a century, so the window ends
+  // in the century before the first whose drift is past it.
+  last = first - first % 100;
+  while (last <= to - 100 && julianGregorianDrift(last + 100) <= high) {
+    last += 100;
+  }
+  scanYears(weeks, first, last <= to - 99 ? last + 99 : to, visit);
+} // forEachWeeksBetween(Weeks, Year, Year, ...)
+
+std::vector<Year> findWeeksBetween(Weeks weeks, Year from, Year to)
+{
+  std::vector<Year> years{};
+  forEachWeeksBetween(weeks, from, to,
+                      [&years](Year year) { years.push_back(year); });
+  return years;
+} // findWeeksBetween(Weeks, Year, Year)
+
+std::uint64_t countWeeksBetween(Weeks weeks, Year from, Year to)
+{
+  std::uint64_t count{0};
+  forEachWeeksBetween(weeks, from, to, [&count](Year) { ++count; });
+  return count;
+} // countWeeksBetween(Weeks, Year, Year)
+
+WeeksBetweenStatistics weeksBetweenStatistics(Year from, Year to)
+{
+  WeeksBetweenStatistics statistics{};
+  from = std::max(from, Year{kGregorianMinYear});
+  to = std::min(to, lastYear());
+  if (from > to) { return statistics; }
+
+  bool any{false};
+  auto extend{[&](Year, Weeks weeks) {
+    if (!any || weeks.value < statistics.least.value) {
+      statistics.least = weeks;
+    }
+    if (!any || weeks.value > statistics.most.value) {
+      statistics.most = weeks;
+    }
+    any = true;
+  }};
+
+  long double sum{0};
+  if (from < 0) {
+    forEachYearWeeks(from, std::min(to, Year{-1}), [&](Year year, Weeks weeks) {
+      extend(year, weeks);
+      sum += static_cast<long double>(weeks.value);
+      ++statistics.years;
+    });
+    from = 0;
+  }
+
+  if (from <= to) {
+    // The days between the dates summed over the years are the sums of the
+    // drift and of the days of each Pascha after 21 March, all of which are
+    // counted without calculating the years.
+    long double drift{sumFloorDiv(to, 100) - sumFloorDiv(from - 1, 100) -
+                      sumFloorDiv(to, 400) + sumFloorDiv(from - 1, 400) -
+                      2.0L * static_cast<long double>(to - from + 1)};
+    sum += (drift + sumOffsets(julianCycle(), from, to) -
+            sumOffsets(gregorianCycle(), from, to)) /
+           7;
+    statistics.years += static_cast<std::uint64_t>(to - from) + 1;
+
+    // A year whose drift is more than twice the most that the days can differ
+    // from it past that of another year is more weeks apart, so the least and
+    // most weeks are in the years near the first and last.
+    Year first_end{from};
+    while (first_end < to &&
+           julianGregorianDrift(first_end + 1) <=
+               julianGregorianDrift(from) + 2 * kMaxOffset) {
+      ++first_end;
+    }
+    Year last_start{to};
+    while (last_start > first_end + 1 &&
+           julianGregorianDrift(last_start - 1) >=
+               julianGregorianDrift(to) - 2 * kMaxOffset) {
+      --last_start;
+    }
+    forEachYearWeeks(from, first_end, extend);
+    if (first_end < to) { forEachYearWeeks(last_start, to, extend); }
+  }
+
+  statistics.mean = static_cast<double>(sum / statistics.years);
+  return statistics;
+} // weeksBetweenStatistics(Year, Year)
+
+void forEachWeeksCount(
+    Year from, Year to,
+    const std::function<void(const WeeksBetweenStatistics::WeeksCount&)>&
+        visit)
+{
+  from = std::max(from, Year{kGregorianMinYear});
+  to = std::min(to, lastYear());
+  if (from > to) { return; }
+
+  // The counts of the weeks that some years before the span may also be, and
+  // of those that some after it may, from the years at either end of it.
+  WeeksHistogram low{};
+  WeeksHistogram high{};
+  auto visitCounts{[&visit](const WeeksHistogram& histogram, CalcInt least,
+                            CalcInt most) {
+    for (CalcInt weeks{least}; weeks <= most; ++weeks) {
+      WeeksCount count{histogram.count(weeks)};
+      if (count.years != 0) { visit(count); }
+    }
+  }};
+
+  if (from < 0) {
+    forEachYearWeeks(from, std::min(to, Year{-1}),
+                     [&low](Year year, Weeks weeks) { low.add(year, weeks); });
+    from = 0;
+  }
+  const PaschaCycle& gregorian{gregorianCycle()};
+  auto count{[&gregorian](WeeksHistogram& histogram, Year first, Year last,
+                          auto counted) {
+    for (Year year{first}; year <= last; ++year) {
+      Weeks weeks{cycleWeeks(gregorian, year)};
+      if (counted(weeks)) { histogram.add(year, weeks); }
+    }
+  }};
+  auto any{[](Weeks) { return true; }};
+
+  // A span shorter than the cycle is counted a year at a time.
+  if (from > to || to - from < kWeeksCycle) {
+    if (from <= to) { count(low, from, to, any); }
+    visitCounts(low, low.least(), low.most());
+    return;
+  }
+
+  // No year before the span is more weeks apart than the first can be, and no
+  // year after it fewer than the last can be. The weeks between are from the
+  // cycle, and only the years that may be at most the first or at least the
+  // last are counted a year at a time.
+  const CalcInt first{(julianGregorianDrift(from) + kMaxOffset) / 7};
+  const CalcInt last{(julianGregorianDrift(to) - kMaxOffset) / 7};
+  count(low, from,
+        firstDriftYear(from, to, 7 * (first + 1) + kMaxOffset) - 1,
+        [first](Weeks weeks) { return weeks.value <= first; });
+  count(high, firstDriftYear(from, to, 7 * last - kMaxOffset), to,
+        [last](Weeks weeks) { return weeks.value >= last; });
+
+  visitCounts(low, low.least(), first);
+  for (CalcInt weeks{first + 1}; weeks < last; ++weeks) {
+    // The negative years are counted with the first.
+    WeeksCount cycle{countCycleWeeks(weeks)};
+    WeeksCount negative{low.count(weeks)};
+    if (negative.years != 0) {
+      cycle.first = negative.first;
+      cycle.years += negative.years;
+    }
+    if (cycle.years != 0) { visit(cycle); }
+  }
+  visitCounts(high, last, high.most());
+} // forEachWeeksCount(Year, Year, ...)
+
+} // namespace pascha
@@ -0,0 +1,198 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "test.h"
+
+#include "pascha/calculation_methods.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/computus.h"
+#include "pascha/gregorian_table.h"
+#include "pascha/i_calculation_method.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+using namespace pascha;
+using test::expectEqual;
+using test::expectTrue;
+
+inline constexpr Year kYearMin{std::numeric_limits<Year>::min()};
+inline constexpr Year kYearMax{std::numeric_limits<Year>::max()};
+
+// Years from first to last, to which sampleYears adds
+void addYears(std::vector<Year>& years, Year first, Year last)
+{
+  for (Year year{first}; year < last; ++year) { years.push_back(year); }
+  years.push_back(last);
+} // addYears
+
+// The years around 0 and at each end of the range min to max, past which a
+// method is in error, and years drawn at random within it.
+std::vector<Year> sampleYears(Year min, Year max)
+{
+  std::vector<Year> years{kYearMin, kYearMax};
+  addYears(years, min - 100, min + 10000);
+  addYears(years, -10000, 10000);
+  addYears(years, max - 10000, max + 100);
+  std::mt19937_64 random{20240};
+  std::uniform_int_distribution<Year> distribution{min, max};
+  for (int i{0}; i < 100000; ++i) { years.push_back(distribution(random)); }
+  return years;
+} // sampleYears
+
+// Check a method against the reference, one year at a time and in a batch.
+void testMethod(std::string_view name, const ICalculationMethod& method,
+                const ICalculationMethod& reference,
+                const std::vector<Year>& years)
+{
+  std::vector<Checked<Date>> expected;
+  std::size_t expected_failed{0};
+  for (Year year : years) {
+    Checked<Date> date{reference.tryCalculate(year)};
+    expected.push_back(date);
+    expected_failed += !date.ok();
+
+    Checked<Date> actual{method.tryCalculate(year)};
+    if (!expectEqual(actual.error, date.error, name, " error of ", year)) {
+      return;
+    }
+    if (date && !expectEqual(*actual, *date, name, " of ", year)) { return; }
+
+    Checked<CalcInt> expected_jdn{reference.tryCalculateJdn(year)};
+    Checked<CalcInt> jdn{method.tryCalculateJdn(year)};
+    if (!expectEqual(jdn.error, expected_jdn.error, name, " JDN error of ",
+                     year)) {
+      return;
+    }
+    if (expected_jdn && !expectEqual(*jdn, *expected_jdn, name, " JDN of ",
+                                     year)) {
+      return;
+    }
+  }
+
+  std::vector<Date> dates(years.size());
+  std::vector<EConversionError> errors(years.size(), e_conversion_error::none);
+  std::size_t failed{method.tryCalculate(std::span<const Year>{years},
+                                         std::span<Date>{dates},
+                                         std::span<EConversionError>{errors})};
+  expectEqual(failed, expected_failed, name, " errors of the batch");
+  for (std::size_t i{0}; i < years.size(); ++i) {
+    if (!expectEqual(errors[i], expected[i].error, name, " batch error of ",
+                     years[i])) {
+      return;
+    }
+    if (expected[i] && !expectEqual(dates[i], *expected[i], name,
+                                    " batch date of ", years[i])) {
+      return;
+    }
+  }
+} // testMethod
+
+void testJulianTable()
+{
+  testMethod("JulianTableCalculationMethod", JulianTableCalculationMethod{},
+             JulianCalculationMethod{},
+             sampleYears(kJulianMinYear, kJulianMaxYear));
+} // testJulianTable
+
+// The years around 0 and around the ends of the cycles of the table, and
+// years drawn at random from the whole range of Year.
+std::vector<Year> sampleGregorianYears()
+{
+  std::vector<Year> years{sampleYears(kYearMin + 100, kYearMax - 100)};
+  for (Year cycle{1}; cycle <= 3; ++cycle) {
+    addYears(years, cycle * kGregorianCycle - 100,
+             cycle * kGregorianCycle + 100);
+  }
+  return years;
+} // sampleGregorianYears
+
+// Check a method that should map the table, or fall back to the computus when
+// it cannot, against the computus.
+void testMapped(std::string_view name, const std::filesystem::path& path,
+                bool mapped)
+{
+  MappedGregorianCalculationMethod method{path.string()};
+#if !defined(_WIN32)
+  expectEqual(method.mapped(), mapped, name, " mapped");
+#endif
+  GregorianCalculationMethod computus{};
+  testMethod(name, method, computus, sampleGregorianYears());
+  for (Year year{0}; year < kGregorianCycle; ++year) {
+    if (!expectEqual(method.tryCalculate(year).value, gregorianPascha(year),
+                     name, " of ", year)) {
+      return;
+    }
+  }
+} // testMapped
+
+void testMappedGregorian()
+{
+  std::filesystem::path directory{std::filesystem::temp_directory_path()};
+  std::filesystem::path path{directory / "pascha_test_gregorian_table.bin"};
+  {
+    std::ofstream out{path, std::ios::binary};
+    writeGregorianTable(out);
+  }
+  testMapped("MappedGregorianCalculationMethod", path, true);
+
+  testMapped("MappedGregorianCalculationMethod without a table",
+             directory / "pascha_test_missing_table.bin", false);
+
+  // Change one byte of the table, so that it no longer matches its checksum
+  std::vector<char> bytes;
+  {
+    std::ifstream in{path, std::ios::binary};
+    bytes.assign(std::istreambuf_iterator<char>{in}, {});
+  }
+  if (expectTrue(bytes.size() > kGregorianTableHeaderSize + 2024,
+                 "size of the written table")) {
+    bytes[kGregorianTableHeaderSize + 2024] ^= 1;
+    {
+      std::ofstream out{path, std::ios::binary};
+      out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    testMapped("MappedGregorianCalculationMethod with a bad checksum", path,
+               false);
+  }
+
+  std::filesystem::remove(path);
+} // testMappedGregorian
+
+} // namespace
+
+namespace pascha::test
+{
+
+void calculationMethodsTest()
+{
+  testJulianTable();
+  testMappedGregorian();
+} // calculationMethodsTest
+
+} // namespace pascha::test
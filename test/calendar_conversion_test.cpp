@@ -0,0 +1,439 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "test.h"
+
+#include "pascha/calculation_options.h"
+#include "pascha/calendar_conversion.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+using namespace pascha;
+using test::expectEqual;
+
+struct FloorCase
+{
+  CalcInt dividend;
+  CalcInt divisor;
+  CalcInt quotient;
+  CalcInt remainder;
+}; // struct FloorCase
+
+inline constexpr CalcInt kCalcMin{std::numeric_limits<CalcInt>::min()};
+inline constexpr CalcInt kCalcMax{std::numeric_limits<CalcInt>::max()};
+
+inline constexpr std::array kFloorCases{
+  FloorCase{7, 4, 1, 3},
+  FloorCase{-7, 4, -2, 1},
+  FloorCase{-8, 4, -2, 0},
+  FloorCase{0, 400, 0, 0},
+  FloorCase{-1, 400, -1, 399},
+  FloorCase{-400, 400, -1, 0},
+  FloorCase{-401, 400, -2, 399},
+  FloorCase{-5508, 900, -7, 792},
+  FloorCase{kCalcMin, 4, -2305843009213693952, 0},
+  FloorCase{kCalcMin + 1, 400, -23058430092136940, 193},
+  FloorCase{kCalcMax, 400, 23058430092136939, 207},
+};
+
+// The conversions of one calendar, so that each check is written once for all
+// of them. The calendars are indexed by EOutputCalendar.
+struct Calendar
+{
+  std::string_view name;
+  CalcInt min_year;
+  CalcInt max_year;
+  EConversionError year_error;
+  // The last JDN that converts to a date of the calendar
+  CalcInt max_jdn;
+  bool (*leap)(CalcInt year);
+  Checked<CalcInt> (*try_to_jdn)(const Date& date);
+  Date (*from_jdn)(CalcInt jdn);
+}; // struct Calendar
+
+constexpr bool julianLeap(CalcInt year) { return floorMod(year, 4) == 0; }
+
+constexpr bool gregorianLeap(CalcInt year)
+{
+  return floorMod(year, 4) == 0 &&
+         (floorMod(year, 100) != 0 || floorMod(year, 400) == 0);
+} // gregorianLeap
+
+constexpr bool revJulianLeap(CalcInt year)
+{
+  CalcInt century_year{floorMod(year, 900)};
+  return floorMod(year, 4) == 0 &&
+         (floorMod(year, 100) != 0 || century_year == 200 ||
+          century_year == 600);
+} // revJulianLeap
+
+inline constexpr std::array kCalendars{
+  Calendar{"julian", kJulianMinYear, kJulianMaxYear,
+           e_conversion_error::julian_year,
+           unchecked::julianToJdn({kJulianMaxYear, 12, 31}), julianLeap,
+           tryJulianToJdn, jdnToJulian},
+  Calendar{"gregorian", kGregorianMinYear, kGregorianMaxYear,
+           e_conversion_error::gregorian_year,
+           unchecked::gregorianToJdn({kGregorianMaxYear, 12, 31}),
+           gregorianLeap, tryGregorianToJdn, jdnToGregorian},
+  Calendar{"rev_julian", kRevJulianMinYear, kRevJulianMaxYear,
+           e_conversion_error::rev_julian_year, kRevJulianMaxJdn,
+           revJulianLeap, tryRevJulianToJdn, jdnToRevJulian},
+};
+
+struct KnownJdn
+{
+  EOutputCalendar calendar;
+  Date date;
+  CalcInt jdn;
+}; // struct KnownJdn
+
+// Dates at the ends of the ranges, around years 0 and -1 and around century
+// years, with their JDNs.
+inline constexpr std::array kKnownJdns{
+  KnownJdn{e_output_calendar::julian, {-5508, 1, 1}, -290739},
+  KnownJdn{e_output_calendar::julian, {-4713, 11, 24}, -38},
+  KnownJdn{e_output_calendar::julian, {-4712, 1, 1}, 0},
+  KnownJdn{e_output_calendar::julian, {-100, 2, 29}, 1684592},
+  KnownJdn{e_output_calendar::julian, {-100, 3, 1}, 1684593},
+  KnownJdn{e_output_calendar::julian, {-1, 12, 31}, 1721057},
+  KnownJdn{e_output_calendar::julian, {0, 1, 1}, 1721058},
+  KnownJdn{e_output_calendar::julian, {0, 2, 29}, 1721117},
+  KnownJdn{e_output_calendar::julian, {1582, 10, 4}, 2299160},
+  KnownJdn{e_output_calendar::julian, {1900, 2, 29}, 2415092},
+  KnownJdn{e_output_calendar::julian, {2000, 1, 1}, 2451558},
+  KnownJdn{e_output_calendar::julian, {kJulianMaxYear, 12, 31},
+           9223372036854775664},
+  KnownJdn{e_output_calendar::gregorian, {-5508, 1, 1}, -290695},
+  KnownJdn{e_output_calendar::gregorian, {-4713, 11, 24}, 0},
+  KnownJdn{e_output_calendar::gregorian, {-401, 12, 31}, 1574962},
+  KnownJdn{e_output_calendar::gregorian, {-400, 2, 29}, 1575022},
+  KnownJdn{e_output_calendar::gregorian, {-100, 2, 28}, 1684594},
+  KnownJdn{e_output_calendar::gregorian, {-100, 3, 1}, 1684595},
+  KnownJdn{e_output_calendar::gregorian, {-1, 12, 31}, 1721059},
+  KnownJdn{e_output_calendar::gregorian, {0, 1, 1}, 1721060},
+  KnownJdn{e_output_calendar::gregorian, {0, 2, 29}, 1721119},
+  KnownJdn{e_output_calendar::gregorian, {1582, 10, 15}, 2299161},
+  KnownJdn{e_output_calendar::gregorian, {1900, 2, 28}, 2415079},
+  KnownJdn{e_output_calendar::gregorian, {1900, 3, 1}, 2415080},
+  KnownJdn{e_output_calendar::gregorian, {2000, 2, 29}, 2451604},
+  KnownJdn{e_output_calendar::gregorian, {kGregorianMaxYear, 12, 31},
+           9223372036854775636},
+  KnownJdn{e_output_calendar::rev_julian, {-5508, 1, 1}, -290693},
+  KnownJdn{e_output_calendar::rev_julian, {-100, 2, 28}, 1684595},
+  KnownJdn{e_output_calendar::rev_julian, {-100, 3, 1}, 1684596},
+  KnownJdn{e_output_calendar::rev_julian, {-1, 12, 31}, 1721060},
+  KnownJdn{e_output_calendar::rev_julian, {0, 1, 1}, 1721061},
+  KnownJdn{e_output_calendar::rev_julian, {0, 2, 28}, 1721119},
+  KnownJdn{e_output_calendar::rev_julian, {0, 3, 1}, 1721120},
+  KnownJdn{e_output_calendar::rev_julian, {1900, 3, 1}, 2415080},
+  KnownJdn{e_output_calendar::rev_julian, {2800, 2, 28}, 2743797},
+  KnownJdn{e_output_calendar::rev_julian, {2800, 3, 1}, 2743798},
+  KnownJdn{e_output_calendar::rev_julian, {2900, 2, 29}, 2780322},
+  KnownJdn{e_output_calendar::rev_julian, {6313173596028016, 4, 5},
+           kRevJulianMaxJdn},
+  KnownJdn{e_output_calendar::rev_julian, {kRevJulianMaxYear, 12, 31},
+           9223372036854775522},
+};
+
+// About 1000 years of days
+inline constexpr CalcInt kWalkDays{365250};
+
+void testFloor()
+{
+  for (const FloorCase& c : kFloorCases) {
+    expectEqual(floorDiv(c.dividend, c.divisor), c.quotient, "floorDiv(",
+                c.dividend, ", ", c.divisor, ")");
+    expectEqual(floorMod(c.dividend, c.divisor), c.remainder, "floorMod(",
+                c.dividend, ", ", c.divisor, ")");
+  }
+} // testFloor
+
+void testKnownJdns()
+{
+  for (const KnownJdn& known : kKnownJdns) {
+    const Calendar& calendar{kCalendars[known.calendar]};
+    Checked<CalcInt> jdn{calendar.try_to_jdn(known.date)};
+    expectEqual(jdn.error, e_conversion_error::none, calendar.name, " ",
+                known.date, " in range");
+    expectEqual(jdn.value, known.jdn, calendar.name, " ", known.date, " JDN");
+    if (known.jdn <= calendar.max_jdn) {
+      expectEqual(calendar.from_jdn(known.jdn), known.date, calendar.name,
+                  " date of JDN ", known.jdn);
+    }
+  }
+} // testKnownJdns
+
+void testRanges()
+{
+  for (const Calendar& calendar : kCalendars) {
+    expectEqual(calendar.try_to_jdn({calendar.min_year, 1, 1}).error,
+                e_conversion_error::none, calendar.name, " first year");
+    expectEqual(calendar.try_to_jdn({calendar.max_year, 12, 31}).error,
+                e_conversion_error::none, calendar.name, " last year");
+    expectEqual(calendar.try_to_jdn({calendar.min_year - 1, 12, 31}).error,
+                calendar.year_error, calendar.name, " year before the first");
+    expectEqual(calendar.try_to_jdn({calendar.max_year + 1, 1, 1}).error,
+                calendar.year_error, calendar.name, " year after the last");
+  }
+  expectEqual(tryJdnToRevJulian(kRevJulianMaxJdn).error,
+              e_conversion_error::none, "last Revised Julian JDN");
+  expectEqual(tryJdnToRevJulian(kRevJulianMaxJdn + 1).error,
+              e_conversion_error::rev_julian_jdn, "JDN after the last");
+} // testRanges
+
+Date nextDay(const Date& date, bool (*leap)(CalcInt year))
+{
+  static constexpr std::array<Day, 12> kMonthDays{31, 28, 31, 30, 31, 30,
+                                                  31, 31, 30, 31, 30, 31};
+  Day month_days{kMonthDays[date.month - 1]};
+  if (date.month == 2 && leap(date.year)) { ++month_days; }
+  if (date.day < month_days) {
+    return {date.year, date.month, static_cast<Day>(date.day + 1)};
+  }
+  if (date.month < 12) {
+    return {date.year, static_cast<Month>(date.month + 1), 1};
+  }
+  return {date.year + 1, 1, 1};
+} // nextDay
+
+// Check that the days from the first JDN follow one another by the leap rule
+// of the calendar, and that each converts back to its JDN.
+void walk(const Calendar& calendar, CalcInt first, CalcInt days)
+{
+  Date previous{calendar.from_jdn(first)};
+  for (CalcInt jdn{first + 1}; jdn < first + days; ++jdn) {
+    Date date{calendar.from_jdn(jdn)};
+    if (!expectEqual(date, nextDay(previous, calendar.leap), calendar.name,
+                     " date of JDN ", jdn)) {
+      return;
+    }
+    if (!expectEqual(calendar.try_to_jdn(date).value, jdn, calendar.name,
+                     " ", date, " JDN")) {
+      return;
+    }
+    previous = date;
+  }
+} // walk
+
+void testWalks()
+{
+  for (const Calendar& calendar : kCalendars) {
+    walk(calendar, calendar.try_to_jdn({calendar.min_year, 1, 1}).value,
+         kWalkDays);
+    // Every century year of the leap rules, around years 0 and -1
+    walk(calendar, calendar.try_to_jdn({-1000, 1, 1}).value, 3 * kWalkDays);
+    walk(calendar, calendar.max_jdn - kWalkDays + 1, kWalkDays);
+  }
+} // testWalks
+
+// Dates in and out of the range of every calendar: the known dates, those at
+// the ends of each range, and random dates.
+std::vector<Date> sampleDates()
+{
+  std::vector<Date> dates;
+  for (const KnownJdn& known : kKnownJdns) { dates.push_back(known.date); }
+  for (const Calendar& calendar : kCalendars) {
+    for (CalcInt year : {calendar.min_year - 1, calendar.min_year,
+                         calendar.max_year, calendar.max_year + 1}) {
+      dates.push_back({year, 1, 1});
+      dates.push_back({year, 12, 31});
+    }
+  }
+  std::mt19937_64 random{20240};
+  std::uniform_int_distribution<CalcInt> near_years{-6000, 6000};
+  std::uniform_int_distribution<CalcInt> all_years{kGregorianMinYear - 100,
+                                                   kRevJulianMaxYear + 100};
+  std::uniform_int_distribution<int> months{1, 12};
+  std::uniform_int_distribution<int> days{1, 28};
+  for (int i{0}; i < 2000; ++i) {
+    CalcInt year{i % 2 == 0 ? near_years(random) : all_years(random)};
+    dates.push_back({year, static_cast<Month>(months(random)),
+                     static_cast<Day>(days(random))});
+  }
+  return dates;
+} // sampleDates
+
+// Check a try batch conversion against its scalar version over every input,
+// and return the inputs that are in range.
+template <typename Out, typename In, typename TryScalar, typename TryBatch>
+std::vector<In> testTryBatch(std::string_view name, const std::vector<In>& in,
+                             TryScalar try_scalar, TryBatch try_batch)
+{
+  std::vector<Out> out(in.size());
+  std::vector<EConversionError> errors(in.size(), e_conversion_error::none);
+  std::size_t failed{try_batch(std::span<const In>{in}, std::span<Out>{out},
+                               std::span<EConversionError>{errors})};
+
+  std::vector<In> valid;
+  std::size_t expected_failed{0};
+  for (std::size_t i{0}; i < in.size(); ++i) {
+    Checked<Out> expected{try_scalar(in[i])};
+    expectEqual(errors[i], expected.error, name, " error of ", in[i]);
+    if (expected) {
+      expectEqual(out[i], *expected, name, " of ", in[i]);
+      valid.push_back(in[i]);
+    } else {
+      ++expected_failed;
+    }
+  }
+  expectEqual(failed, expected_failed, name, " errors");
+  return valid;
+} // testTryBatch
+
+// Check a batch conversion against its scalar version over inputs in range.
+template <typename Out, typename In, typename Scalar, typename Batch>
+void testBatch(std::string_view name, const std::vector<In>& in, Scalar scalar,
+               Batch batch)
+{
+  std::vector<Out> out(in.size());
+  batch(std::span<const In>{in}, std::span<Out>{out});
+  for (std::size_t i{0}; i < in.size(); ++i) {
+    expectEqual(out[i], scalar(in[i]), name, " of ", in[i]);
+  }
+} // testBatch
+
+void testBatches()
+{
+  const std::vector<Date> dates{sampleDates()};
+
+  std::vector<Date> valid{testTryBatch<CalcInt>(
+    "tryJulianToJdn", dates,
+    [](const Date& date) { return tryJulianToJdn(date); },
+    [](auto in, auto out, auto errors) {
+      return tryJulianToJdn(in, out, errors);
+    })};
+  testBatch<CalcInt>(
+    "julianToJdn", valid, [](const Date& date) { return julianToJdn(date); },
+    [](auto in, auto out) { julianToJdn(in, out); });
+  std::vector<CalcInt> jdns;
+  for (const Date& date : valid) { jdns.push_back(julianToJdn(date)); }
+  testBatch<Date>(
+    "jdnToJulian", jdns, [](CalcInt jdn) { return jdnToJulian(jdn); },
+    [](auto in, auto out) { jdnToJulian(in, out); });
+
+  valid = testTryBatch<CalcInt>(
+    "tryGregorianToJdn", dates,
+    [](const Date& date) { return tryGregorianToJdn(date); },
+    [](auto in, auto out, auto errors) {
+      return tryGregorianToJdn(in, out, errors);
+    });
+  testBatch<CalcInt>(
+    "gregorianToJdn", valid,
+    [](const Date& date) { return gregorianToJdn(date); },
+    [](auto in, auto out) { gregorianToJdn(in, out); });
+  jdns.clear();
+  for (const Date& date : valid) { jdns.push_back(gregorianToJdn(date)); }
+  testBatch<Date>(
+    "jdnToGregorian", jdns, [](CalcInt jdn) { return jdnToGregorian(jdn); },
+    [](auto in, auto out) { jdnToGregorian(in, out); });
+
+  valid = testTryBatch<CalcInt>(
+    "tryRevJulianToJdn", dates,
+    [](const Date& date) { return tryRevJulianToJdn(date); },
+    [](auto in, auto out, auto errors) {
+      return tryRevJulianToJdn(in, out, errors);
+    });
+  testBatch<CalcInt>(
+    "revJulianToJdn", valid,
+    [](const Date& date) { return revJulianToJdn(date); },
+    [](auto in, auto out) { revJulianToJdn(in, out); });
+  // The Revised Julian dates of the end of the range are past its last JDN
+  jdns.clear();
+  for (const Date& date : valid) { jdns.push_back(revJulianToJdn(date)); }
+  std::vector<CalcInt> valid_jdns{testTryBatch<Date>(
+    "tryJdnToRevJulian", jdns,
+    [](CalcInt jdn) { return tryJdnToRevJulian(jdn); },
+    [](auto in, auto out, auto errors) {
+      return tryJdnToRevJulian(in, out, errors);
+    })};
+  testBatch<Date>(
+    "jdnToRevJulian", valid_jdns,
+    [](CalcInt jdn) { return jdnToRevJulian(jdn); },
+    [](auto in, auto out) { jdnToRevJulian(in, out); });
+
+  valid = testTryBatch<Date>(
+    "tryGregorianToJulian", dates,
+    [](const Date& date) { return tryGregorianToJulian(date); },
+    [](auto in, auto out, auto errors) {
+      return tryGregorianToJulian(in, out, errors);
+    });
+  testBatch<Date>(
+    "gregorianToJulian", valid,
+    [](const Date& date) { return gregorianToJulian(date); },
+    [](auto in, auto out) { gregorianToJulian(in, out); });
+
+  valid = testTryBatch<Date>(
+    "tryJulianToGregorian", dates,
+    [](const Date& date) { return tryJulianToGregorian(date); },
+    [](auto in, auto out, auto errors) {
+      return tryJulianToGregorian(in, out, errors);
+    });
+  testBatch<Date>(
+    "julianToGregorian", valid,
+    [](const Date& date) { return julianToGregorian(date); },
+    [](auto in, auto out) { julianToGregorian(in, out); });
+
+  valid = testTryBatch<Date>(
+    "tryGregorianToRevJulian", dates,
+    [](const Date& date) { return tryGregorianToRevJulian(date); },
+    [](auto in, auto out, auto errors) {
+      return tryGregorianToRevJulian(in, out, errors);
+    });
+  testBatch<Date>(
+    "gregorianToRevJulian", valid,
+    [](const Date& date) { return gregorianToRevJulian(date); },
+    [](auto in, auto out) { gregorianToRevJulian(in, out); });
+
+  valid = testTryBatch<Date>(
+    "tryRevJulianToGregorian", dates,
+    [](const Date& date) { return tryRevJulianToGregorian(date); },
+    [](auto in, auto out, auto errors) {
+      return tryRevJulianToGregorian(in, out, errors);
+    });
+  testBatch<Date>(
+    "revJulianToGregorian", valid,
+    [](const Date& date) { return revJulianToGregorian(date); },
+    [](auto in, auto out) { revJulianToGregorian(in, out); });
+} // testBatches
+
+} // namespace
+
+namespace pascha::test
+{
+
+void calendarConversionTest()
+{
+  testFloor();
+  testKnownJdns();
+  testRanges();
+  testWalks();
+  testBatches();
+} // calendarConversionTest
+
+} // namespace pascha::test
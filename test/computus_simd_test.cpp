@@ -0,0 +1,123 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "test.h"
+
+#include "computus_simd.h"
+#include "pascha/calendar_conversion.h"
+#include "pascha/computus.h"
+
+#include <array>
+#include <cstdint>
+#include <random>
+
+namespace
+{
+using namespace pascha;
+using test::expectEqual;
+
+using Lanes = std::array<Year, simd::kLanes>;
+
+// Check the kernels against the scalar computus for one group of years.
+// Returns whether every lane matches.
+bool testJulianLanes(const Lanes& years)
+{
+  std::array<Date, simd::kLanes> dates{};
+  simd::julianPascha(years.data(), dates.data());
+  for (std::size_t i{0}; i < simd::kLanes; ++i) {
+    if (!expectEqual(dates[i], julianToGregorian(julianPascha(years[i])),
+                     "simd::julianPascha of ", years[i])) {
+      return false;
+    }
+  }
+  return true;
+} // testJulianLanes
+
+bool testGregorianLanes(const Lanes& years)
+{
+  std::array<Date, simd::kLanes> dates{};
+  simd::gregorianPascha(years.data(), dates.data());
+  for (std::size_t i{0}; i < simd::kLanes; ++i) {
+    if (!expectEqual(dates[i], gregorianPascha(years[i]),
+                     "simd::gregorianPascha of ", years[i])) {
+      return false;
+    }
+  }
+  return true;
+} // testGregorianLanes
+
+// Check the consecutive years from first to last in groups of lanes
+template <typename TestLanes>
+void testYears(Year first, Year last, TestLanes test_lanes)
+{
+  Lanes years{};
+  for (Year year{first}; year <= last;) {
+    for (Year& lane : years) {
+      lane = year;
+      year = year < last ? year + 1 : year;
+    }
+    if (!test_lanes(years) || years.back() == last) { return; }
+  }
+} // testYears
+
+// Check groups of years drawn at random from first to last, so that the lanes
+// of a group are far apart.
+template <typename TestLanes>
+void testRandomYears(Year first, Year last, TestLanes test_lanes)
+{
+  std::mt19937_64 random{20240};
+  std::uniform_int_distribution<Year> distribution{first, last};
+  Lanes years{};
+  for (int i{0}; i < 100000; ++i) {
+    for (Year& lane : years) { lane = distribution(random); }
+    if (!test_lanes(years)) { return; }
+  }
+} // testRandomYears
+
+void testJulian()
+{
+  // Every year of the range of the kernel
+  testYears(simd::kJulianMinYear, simd::kJulianMaxYear, testJulianLanes);
+  testRandomYears(simd::kJulianMinYear, simd::kJulianMaxYear, testJulianLanes);
+} // testJulian
+
+void testGregorian()
+{
+  testYears(simd::kGregorianMinYear, simd::kGregorianMinYear + 1000000,
+            testGregorianLanes);
+  testYears(-1000000, 1000000, testGregorianLanes);
+  testYears(simd::kGregorianMaxYear - 1000000, simd::kGregorianMaxYear,
+            testGregorianLanes);
+  testRandomYears(simd::kGregorianMinYear, simd::kGregorianMaxYear,
+                  testGregorianLanes);
+} // testGregorian
+
+} // namespace
+
+namespace pascha::test
+{
+
+void computusSimdTest()
+{
+  testJulian();
+  testGregorian();
+} // computusSimdTest
+
+} // namespace pascha::test
@@ -0,0 +1,100 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#include "test.h"
+
+#include <array>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Suite
+{
+  std::string_view name;
+  void (*run)();
+}; // struct Suite
+
+inline constexpr std::array kSuites{
+  Suite{"calculation_methods", pascha::test::calculationMethodsTest},
+  Suite{"calendar_conversion", pascha::test::calendarConversionTest},
+  Suite{"computus_simd", pascha::test::computusSimdTest},
+};
+
+int g_failures{0};
+
+} // namespace
+
+namespace pascha
+{
+
+std::ostream& operator<<(std::ostream& os, const Date& date)
+{
+  return os << date.year << '-' << date.month << '-' << date.day;
+} // operator<<
+
+} // namespace pascha
+
+namespace pascha::test
+{
+
+void fail(const std::string& message)
+{
+  ++g_failures;
+  std::cerr << "FAILED: " << message << '\n';
+} // fail
+
+} // namespace pascha::test
+
+// Run the suites named in the arguments, or every suite without arguments.
+int main(int argc, char* argv[])
+{
+  std::vector<const Suite*> selected;
+  for (int i{1}; i < argc; ++i) {
+    const Suite* found{nullptr};
+    for (const Suite& suite : kSuites) {
+      if (suite.name == argv[i]) { found = &suite; }
+    }
+    if (found == nullptr) {
+      std::cerr << "Unknown suite: " << argv[i] << '\n';
+      return EXIT_FAILURE;
+    }
+    selected.push_back(found);
+  }
+  if (selected.empty()) {
+    for (const Suite& suite : kSuites) { selected.push_back(&suite); }
+  }
+
+  for (const Suite* suite : selected) {
+    int failures_before{g_failures};
+    try {
+      suite->run();
+    } catch (const std::exception& e) {
+      pascha::test::fail(std::string{"unexpected exception: "} + e.what());
+    }
+    std::cout << suite->name << ": "
+              << (g_failures == failures_before ? "passed" : "FAILED") << '\n';
+  }
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+} // main
@@ -0,0 +1,81 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-lib: A library for calculating the date of Pascha (Easter).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+#ifndef PASCHA_TEST_H
+#define PASCHA_TEST_H
+
+#include "pascha/date.h"
+
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// A small harness for the unit tests of pascha-lib without any dependency
+// outside the tree. Each suite is a function that records its failed checks,
+// and is run as its own CTest test.
+
+namespace pascha
+{
+
+// Write a date as year-month-day in the messages of failed checks.
+std::ostream& operator<<(std::ostream& os, const Date& date);
+
+} // namespace pascha
+
+namespace pascha::test
+{
+
+// Record a failed check and print its message.
+void fail(const std::string& message);
+
+// Check that actual equals expected, recording a failure described by the
+// context if not. The context is only formatted on failure, so that a check
+// in a loop over millions of days stays cheap. Returns whether the check
+// passed, so that a loop can stop at its first failure.
+template <typename T, typename U, typename... Context>
+bool expectEqual(const T& actual, const U& expected, const Context&... context)
+{
+  if (actual == expected) { return true; }
+  std::ostringstream message;
+  (message << ... << context);
+  message << ": got " << actual << ", expected " << expected;
+  fail(message.str());
+  return false;
+} // expectEqual
+
+template <typename... Context>
+bool expectTrue(bool condition, const Context&... context)
+{
+  if (condition) { return true; }
+  std::ostringstream message;
+  (message << ... << context);
+  fail(message.str());
+  return false;
+} // expectTrue
+
+// The suites
+void calculationMethodsTest();
+void calendarConversionTest();
+void computusSimdTest();
+
+} // namespace pascha::test
+
+#endif // !PASCHA_TEST_H
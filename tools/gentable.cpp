@@ -0,0 +1,46 @@
+// Copyright (C) 2024 Christopher Michael Mescher
+//
+// pascha-cli: A CLI Pascha (Easter) date calculator.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+// Contact !(echo \<pascha-mescher+faith\>|sed s/\+/./g\;s/\-/@/) for bug
+// reporting.
+
+// Writes the table of the Gregorian Paschalion used by
+// MappedGregorianCalculationMethod to the file given as the only argument.
+
+#include "pascha/gregorian_table.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <FILE>\n";
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream out{argv[1], std::ios::binary | std::ios::trunc};
+  pascha::writeGregorianTable(out);
+  out.close();
+
+  if (!out) {
+    std::cerr << "Error: Could not write " << argv[1] << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+} // main()